@@ -80,6 +80,8 @@ BrainwaveEntrainmentFXAudioProcessorEditor::BrainwaveEntrainmentFXAudioProcessor
     statusLabel.setJustificationType(juce::Justification::centred);
     addAndMakeVisible(statusLabel);
 
+    // Frames queued while no editor was open are stale
+    audioProcessor.getMeterRing().skipAll();
     startTimerHz(30);
 }
 
@@ -193,7 +195,13 @@ void BrainwaveEntrainmentFXAudioProcessorEditor::paint(juce::Graphics& g) {
 // ============================================================================
 
 void BrainwaveEntrainmentFXAudioProcessorEditor::timerCallback() {
-    currentEnvelope = audioProcessor.getCurrentEnvelope();
+    // Every block since the last tick counts, so short sidechain hits still
+    // show; the meter then falls about 20 dB per second
+    auto envelope = 0.0f;
+    audioProcessor.getMeterRing().drain([&](const MeterFrame& frame) {
+        envelope = juce::jmax(envelope, frame.envelope);
+    });
+    currentEnvelope = juce::jmax(envelope, currentEnvelope * 0.93f);
 
     if (audioProcessor.isActive()) {
         auto beatHz = audioProcessor.getCurrentBeatFrequency();
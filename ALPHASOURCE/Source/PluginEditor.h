@@ -60,8 +60,8 @@ private:
     juce::Label hemiDriftLabel;
     juce::Label statusLabel;
 
-    // Metering
-    float currentEnvelope = 0.0f;
+    // Metering, fed from the processor's meter ring once per timer tick
+    float currentEnvelope = 0.0f;   // highest sidechain envelope since the last tick, with release
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BrainwaveEntrainmentFXAudioProcessorEditor)
 };
\ No newline at end of file
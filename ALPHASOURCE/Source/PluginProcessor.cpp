@@ -1,6 +1,53 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+#if BRAINWAVE_CHECK_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+
+// Replacement global allocation functions, so ScopedNoAllocations can see
+// every heap allocation (see AllocationCheck.h)
+void* operator new(std::size_t size) {
+    AllocationCheck::noteAllocation();
+
+    if (auto* memory = std::malloc(size > 0 ? size : 1))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+// GCC flags the inlined free() as not matching operator new, not knowing
+// this file replaces both
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+void operator delete[](void* memory) noexcept {
+    operator delete(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    operator delete(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    operator delete(memory);
+}
+#endif
+
 // ============================================================================
 // AUDIO PROCESSOR EDITOR IMPLEMENTATION
 // ============================================================================
@@ -19,30 +66,30 @@ BrainwaveEntrainmentFXAudioProcessor::BrainwaveEntrainmentFXAudioProcessor()
         .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
     parameters(*this, nullptr, "Parameters", createParameterLayout()) {
 
-    // Add parameter listeners
-    parameters.addParameterListener("brainwave_frequency", this);
-    parameters.addParameterListener("processing_mode", this);
-    parameters.addParameterListener("carrier_frequency", this);
-    parameters.addParameterListener("beat_offset", this);
-    parameters.addParameterListener("wet_dry_mix", this);
-    parameters.addParameterListener("carrier_blend", this);
-    parameters.addParameterListener("stereo_width", this);
+    // Parameters read every block, so the audio thread never looks them up by name
+    paramPointers.bypass = parameters.getRawParameterValue("bypass");
+    paramPointers.brainwaveFrequency = parameters.getRawParameterValue("brainwave_frequency");
+    paramPointers.beatOffset = parameters.getRawParameterValue("beat_offset");
+    paramPointers.modulationDepth = parameters.getRawParameterValue("modulation_depth");
+    paramPointers.sidechainDepth = parameters.getRawParameterValue("sidechain_depth");
+    paramPointers.hemiDrift = parameters.getRawParameterValue("hemisync_drift");
+    paramPointers.hemiCorrelation = parameters.getRawParameterValue("hemisync_correlation");
+
+    // Listener-driven settings
+    for (int i = 0; i < numParameterTargets; ++i) {
+        auto* id = getParameterId(static_cast<ParameterTarget>(i));
+        targetValues[static_cast<size_t>(i)] = parameters.getRawParameterValue(id);
+        parameters.addParameterListener(id, this);
+    }
+
     parameters.addParameterListener("bypass", this);
-    parameters.addParameterListener("hemisync_correlation", this);
-    parameters.addParameterListener("hemisync_drift", this);
 }
 
 BrainwaveEntrainmentFXAudioProcessor::~BrainwaveEntrainmentFXAudioProcessor() {
-    parameters.removeParameterListener("brainwave_frequency", this);
-    parameters.removeParameterListener("processing_mode", this);
-    parameters.removeParameterListener("carrier_frequency", this);
-    parameters.removeParameterListener("beat_offset", this);
-    parameters.removeParameterListener("wet_dry_mix", this);
-    parameters.removeParameterListener("carrier_blend", this);
-    parameters.removeParameterListener("stereo_width", this);
+    for (int i = 0; i < numParameterTargets; ++i)
+        parameters.removeParameterListener(getParameterId(static_cast<ParameterTarget>(i)), this);
+
     parameters.removeParameterListener("bypass", this);
-    parameters.removeParameterListener("hemisync_correlation", this);
-    parameters.removeParameterListener("hemisync_drift", this);
 }
 
 // ============================================================================
@@ -50,12 +97,15 @@ BrainwaveEntrainmentFXAudioProcessor::~BrainwaveEntrainmentFXAudioProcessor() {
 // ============================================================================
 
 void BrainwaveEntrainmentFXAudioProcessor::prepareToPlay(double sr, int samplesPerBlock) {
-    juce::ignoreUnused(samplesPerBlock);
-
     sampleRate = sr;
 
+    // Kernels for the widest instruction set this CPU runs (see SimdDispatch.h)
+    simdTier = SimdDispatch::selectTier();
+
     carrierOsc.setSampleRate(sr);
-    envelopeFollower.setSampleRate(sr);
+    envelopeFollower.setAttackTime(10.0f);
+    envelopeFollower.setReleaseTime(100.0f);
+    envelopeFollower.prepare(sr);
 
     // Setup smoothed values
     currentBeatHz.reset(sr, 0.05);
@@ -65,25 +115,79 @@ void BrainwaveEntrainmentFXAudioProcessor::prepareToPlay(double sr, int samplesP
     stereoWidth.reset(sr, 0.05);
 
     // Setup filters for spectral asymmetry
-    leftFilter.setLowpass(sr, 2000.0f, 0.707f);
-    rightFilter.setLowpass(sr, 2400.0f, 0.707f);
+    spectralFilters.setLowpass(0, sr, 2000.0f, 0.707f);
+    spectralFilters.setLowpass(1, sr, 2400.0f, 0.707f);
 
     // Setup crossover filters for binaural pan mode
-    leftSplitLow.setLowpass(sr, 500.0f, 0.707f);
-    leftSplitHigh.setHighpass(sr, 500.0f, 0.707f);
-    rightSplitLow.setLowpass(sr, 500.0f, 0.707f);
-    rightSplitHigh.setHighpass(sr, 500.0f, 0.707f);
+    crossover.setLowpass(0, sr, 500.0f, 0.707f);
+    crossover.setHighpass(1, sr, 500.0f, 0.707f);
+    crossover.setLowpass(2, sr, 500.0f, 0.707f);
+    crossover.setHighpass(3, sr, 500.0f, 0.707f);
+
+    // Beat-rate curves are cubic between control points; drift is slow enough for lines
+    isochronicPulse.setSampleRate(sr);
+
+    for (auto* lfo : { &beatLfo, &halfBeatLfo }) {
+        lfo->setSampleRate(sr);
+        lfo->setControlInterval(32);
+    }
+    for (auto* lfo : { &hemiLeftLfo, &hemiRightLfo }) {
+        lfo->setSampleRate(sr);
+        lfo->setControlInterval(hemiControlInterval);
+    }
+    driftLfo.setSampleRate(sr);
+    driftLfo.setControlInterval(64);
+    driftLfo.setInterpolation(ControlRateLfo<MathTier::driftLfo>::Interpolation::Linear);
 
-    updateFrequencies();
+    noiseGen.prepare(sr);
+
+    // Scratch for one processing chunk, whatever block size the host sends
+    juce::ignoreUnused(samplesPerBlock);
+    controlBuffer.setSize(NumControlChannels, processingChunkSize);
+
+    // Nothing is rendering yet: take every listener-driven setting as it is now
+    commandQueue.drain([](const ParameterCommand&) {});
+    commandQueue.checkAndClearOverflow();
+    applyAllParameters();
+
+    // Start at the current settings rather than gliding to them
+    currentBeatHz.setCurrentAndTargetValue(takeSnapshot().beatHz);
+    carrierHz.setCurrentAndTargetValue(carrierHz.getTargetValue());
+    wetDryMix.setCurrentAndTargetValue(wetDryMix.getTargetValue());
+    carrierBlend.setCurrentAndTargetValue(carrierBlend.getTargetValue());
+    stereoWidth.setCurrentAndTargetValue(stereoWidth.getTargetValue());
 }
 
 void BrainwaveEntrainmentFXAudioProcessor::releaseResources() {
+    controlBuffer.setSize(0, 0);
 }
 
 void BrainwaveEntrainmentFXAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     juce::MidiBuffer& midiMessages) {
     juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+void BrainwaveEntrainmentFXAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer,
+    juce::MidiBuffer& midiMessages) {
+    juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+// Shared by both precisions: the modes process a float copy of the input,
+// and only the dry signal and the final mix are carried as SampleType
+template <typename SampleType>
+void BrainwaveEntrainmentFXAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer) {
     juce::ScopedNoDenormals noDenormals;
+    ScopedNoAllocations noAllocations;
+
+    // Settings changed since the last block all land before it is rendered,
+    // so a preset change applies as a whole
+    commandQueue.drain([this](const ParameterCommand& command) { applyCommand(command); });
+    if (commandQueue.checkAndClearOverflow())
+        applyAllParameters();
+
+    auto snapshot = takeSnapshot();
 
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -93,248 +197,503 @@ void BrainwaveEntrainmentFXAudioProcessor::processBlock(juce::AudioBuffer<float>
         buffer.clear(i, 0, buffer.getNumSamples());
 
     // Bypass check
-    auto bypass = parameters.getRawParameterValue("bypass")->load() > 0.5f;
-    if (bypass || totalNumInputChannels < 2) {
+    if (snapshot.bypass || totalNumInputChannels < 2) {
         return; // Pass through unprocessed
     }
 
-    processAudio(buffer);
+    // Process in fixed chunks, each a view onto the host buffer, so the
+    // scratch buffer never needs more than one chunk
+    SampleType* chunkChannels[2] = {};
+    blockMeters.reset();
+
+    for (int start = 0; start < buffer.getNumSamples(); start += processingChunkSize) {
+        auto chunkSize = juce::jmin(processingChunkSize, buffer.getNumSamples() - start);
+
+        for (int channel = 0; channel < 2; ++channel)
+            chunkChannels[channel] = buffer.getWritePointer(channel, start);
+
+        juce::AudioBuffer<SampleType> chunk(chunkChannels, 2, chunkSize);
+        processAudio(chunk, snapshot);
+    }
 
-    samplesProcessed += buffer.getNumSamples();
+    meterRing.push(blockMeters.getFrame());
 }
 
-void BrainwaveEntrainmentFXAudioProcessor::processAudio(juce::AudioBuffer<float>& buffer) {
+template <typename SampleType>
+void BrainwaveEntrainmentFXAudioProcessor::processAudio(juce::AudioBuffer<SampleType>& buffer, const ParamSnapshot& snapshot) {
     auto* leftChannel = buffer.getWritePointer(0);
     auto* rightChannel = buffer.getWritePointer(1);
 
     auto numSamples = buffer.getNumSamples();
 
+    // The modes and the detector read float input; a double-precision block
+    // is converted into scratch first
+    const float* input[2] = {};
+
+    if constexpr (std::is_same_v<SampleType, float>) {
+        input[0] = leftChannel;
+        input[1] = rightChannel;
+    }
+    else {
+        auto* inputL = controlBuffer.getWritePointer(InputLeft);
+        auto* inputR = controlBuffer.getWritePointer(InputRight);
+
+        for (int sample = 0; sample < numSamples; ++sample) {
+            inputL[sample] = static_cast<float>(leftChannel[sample]);
+            inputR[sample] = static_cast<float>(rightChannel[sample]);
+        }
+
+        input[0] = inputL;
+        input[1] = inputR;
+    }
+
     // Get parameters
-    auto wetDry = parameters.getRawParameterValue("wet_dry_mix")->load();
-    auto carrierMix = parameters.getRawParameterValue("carrier_blend")->load();
-    auto widthParam = parameters.getRawParameterValue("stereo_width")->load();
-    auto hemiDrift = parameters.getRawParameterValue("hemisync_drift")->load();
-    auto sidechainDepth = parameters.getRawParameterValue("sidechain_depth")->load();
-    auto modulationDepth = parameters.getRawParameterValue("modulation_depth")->load();
+    auto hemiDrift = snapshot.hemiDrift;
+    auto sidechainDepth = snapshot.sidechainDepth;
+    auto modulationDepth = snapshot.modulationDepth;
+
+    correlationAmount = snapshot.hemiCorrelation;
+    currentBeatHz.setTargetValue(snapshot.beatHz);
+
+    auto* beatRamp = controlBuffer.getWritePointer(BeatHzRamp);
+    auto* wetRamp = controlBuffer.getWritePointer(WetRamp);
+    auto* carrierAmountRamp = controlBuffer.getWritePointer(CarrierAmountRamp);
+    auto* widthRamp = controlBuffer.getWritePointer(WidthRamp);
+
+    // The carrier tone is added for the whole block while its blend is audible
+    bool carrierOn = juce::jmax(carrierBlend.getCurrentValue(), carrierBlend.getTargetValue()) > 0.01f;
+
+    // Smoothed values, one per sample
+    for (int sample = 0; sample < numSamples; ++sample) {
+        beatRamp[sample] = currentBeatHz.getNextValue();
+        wetRamp[sample] = wetDryMix.getNextValue();
+        carrierAmountRamp[sample] = carrierBlend.getNextValue();
+        widthRamp[sample] = stereoWidth.getNextValue();
+    }
+    carrierHz.skip(numSamples);
+
+    // Sidechain envelope, detected per sub-block from the dry input
+    envelopeFollower.processBlock(input, 2, numSamples, controlBuffer.getWritePointer(InputEnvelope));
+
+    // ================================================================
+    // PROCESSING MODES
+    // ================================================================
+
+    ModeBlock block;
+    block.inputL = input[0];
+    block.inputR = input[1];
+    block.modulationDepth = modulationDepth;
+    block.sidechainDepth = sidechainDepth;
+    block.hemiDrift = hemiDrift;
+    block.numSamples = numSamples;
+
+    auto flags = (sidechainDepth > 0.01f ? SidechainOn : 0) | (hemiDrift > 0.0f ? DriftOn : 0);
+    auto kernel = modeKernels[static_cast<size_t>(simdTier)][static_cast<size_t>(currentMode)][static_cast<size_t>(flags)];
+    (this->*kernel)(block);
+
+    switch (simdTier) {
+#if BRAINWAVE_SIMD_DISPATCH
+    case SimdTier::Avx512: mixWetSignalAvx512(buffer, carrierOn); break;
+    case SimdTier::Avx2:   mixWetSignalAvx2(buffer, carrierOn); break;
+#endif
+    default:               mixWetSignal(buffer, carrierOn); break;
+    }
+
+    // Levels for the editor's meters, pushed once the whole block is done
+    MeterFrame meters;
+    meters.peakLeft = static_cast<float>(buffer.getMagnitude(0, 0, numSamples));
+    meters.peakRight = static_cast<float>(buffer.getMagnitude(1, 0, numSamples));
+    meters.rmsLeft = static_cast<float>(buffer.getRMSLevel(0, 0, numSamples));
+    meters.rmsRight = static_cast<float>(buffer.getRMSLevel(1, 0, numSamples));
+    meters.entrainment = 0.5f * (controlBuffer.getRMSLevel(WetLeft, 0, numSamples)
+        + controlBuffer.getRMSLevel(WetRight, 0, numSamples));
+    meters.envelope = envelopeFollower.getEnvelope();
+    meters.numSamples = numSamples;
+    blockMeters.add(meters);
+}
 
-    correlationAmount = parameters.getRawParameterValue("hemisync_correlation")->load();
+template <typename SampleType>
+void BrainwaveEntrainmentFXAudioProcessor::mixWetSignal(juce::AudioBuffer<SampleType>& buffer, bool carrierOn) {
+    auto* leftChannel = buffer.getWritePointer(0);
+    auto* rightChannel = buffer.getWritePointer(1);
 
-    // Create dry buffer copy for wet/dry mixing
-    juce::AudioBuffer<float> dryBuffer(2, numSamples);
-    dryBuffer.copyFrom(0, 0, leftChannel, numSamples);
-    dryBuffer.copyFrom(1, 0, rightChannel, numSamples);
+    auto numSamples = buffer.getNumSamples();
+
+    auto* wetRamp = controlBuffer.getReadPointer(WetRamp);
+    auto* carrierAmountRamp = controlBuffer.getReadPointer(CarrierAmountRamp);
+    auto* widthRamp = controlBuffer.getReadPointer(WidthRamp);
+    auto* wetL = controlBuffer.getWritePointer(WetLeft);
+    auto* wetR = controlBuffer.getWritePointer(WetRight);
+
+    // Add carrier tone if enabled
+    if (carrierOn) {
+        for (int sample = 0; sample < numSamples; ++sample) {
+            float carrierSample = carrierOsc.process() * carrierAmountRamp[sample] * 0.3f;
+            wetL[sample] += carrierSample;
+            wetR[sample] += carrierSample;
+        }
+    }
 
+    // Stereo width adjustment and wet/dry mix; the buffer still holds the dry input
     for (int sample = 0; sample < numSamples; ++sample) {
-        float beatHz = currentBeatHz.getNextValue();
-        float carrier = carrierHz.getNextValue();
-        float wet = wetDryMix.getNextValue();
-        float carrierAmount = carrierBlend.getNextValue();
-        float width = stereoWidth.getNextValue();
-
-        float time = static_cast<float>(samplesProcessed + sample) / static_cast<float>(sampleRate);
-
-        // Get input samples
-        float inputL = leftChannel[sample];
-        float inputR = rightChannel[sample];
-
-        // Envelope following for sidechain modulation
-        float inputEnv = envelopeFollower.process((std::abs(inputL) + std::abs(inputR)) * 0.5f);
-        currentEnvelope = inputEnv;
-
-        float outputL = 0.0f;
-        float outputR = 0.0f;
-
-        // ================================================================
-        // PROCESSING MODES
-        // ================================================================
-
-        switch (currentMode) {
-            // ============================================================
-            // BINAURAL PAN - Frequency-dependent L/R separation
-            // ============================================================
-        case ProcessingMode::BinauralPan: {
-            // Split audio into low and high bands
-            float lowL = leftSplitLow.process(inputL);
-            float highL = leftSplitHigh.process(inputL);
-            float lowR = rightSplitLow.process(inputR);
-            float highR = rightSplitHigh.process(inputR);
-
-            // Pan modulation at brainwave frequency
-            float pan = std::sin(juce::MathConstants<float>::twoPi * beatHz * time);
+        float mid = (wetL[sample] + wetR[sample]) * 0.5f;
+        float side = (wetL[sample] - wetR[sample]) * 0.5f;
+
+        float outputL = mid + side * widthRamp[sample];
+        float outputR = mid - side * widthRamp[sample];
+
+        auto wet = static_cast<SampleType>(wetRamp[sample]);
+        leftChannel[sample] = leftChannel[sample] * (SampleType(1) - wet) + static_cast<SampleType>(outputL) * wet;
+        rightChannel[sample] = rightChannel[sample] * (SampleType(1) - wet) + static_cast<SampleType>(outputR) * wet;
+    }
+}
+
+// ============================================================================
+// MODE KERNELS
+// ============================================================================
+
+template <ProcessingMode Mode, bool WithSidechain, bool WithDrift>
+void BrainwaveEntrainmentFXAudioProcessor::renderMode(const ModeBlock& block) {
+    auto numSamples = block.numSamples;
+    auto modulationDepth = block.modulationDepth;
+    auto sidechainDepth = block.sidechainDepth;
+
+    auto* inputL = block.inputL;
+    auto* inputR = block.inputR;
+
+    auto* beatRamp = controlBuffer.getReadPointer(BeatHzRamp);
+    auto* envelopeRamp = controlBuffer.getReadPointer(InputEnvelope);
+    auto* modL = controlBuffer.getWritePointer(LeftModulator);
+    auto* modR = controlBuffer.getWritePointer(RightModulator);
+    auto* outputL = controlBuffer.getWritePointer(WetLeft);
+    auto* outputR = controlBuffer.getWritePointer(WetRight);
+
+    // ============================================================
+    // BINAURAL PAN - Frequency-dependent L/R separation
+    // ============================================================
+    if constexpr (Mode == ProcessingMode::BinauralPan) {
+        // Pan modulation at brainwave frequency
+        beatLfo.processBlock(modL, beatRamp, numSamples);
+
+        // Split audio into low and high bands, all four in one register. The
+        // lows land in the outputs and are panned in place.
+        auto* highLeft = controlBuffer.getWritePointer(HighLeft);
+        auto* highRight = controlBuffer.getWritePointer(HighRight);
+        const float* bandInputs[] = { inputL, inputL, inputR, inputR };
+        float* bands[] = { outputL, highLeft, outputR, highRight };
+        crossover.processBlock(bandInputs, bands, 4, numSamples);
+
+        for (int sample = 0; sample < numSamples; ++sample) {
+            float lowL = outputL[sample];
+            float highL = highLeft[sample];
+            float lowR = outputR[sample];
+            float highR = highRight[sample];
 
             // Apply frequency-dependent panning
             // Low frequencies stay centered, highs pan
-            float panGainL = 0.5f * (1.0f - pan * modulationDepth);
-            float panGainR = 0.5f * (1.0f + pan * modulationDepth);
+            float panGainL = 0.5f * (1.0f - modL[sample] * modulationDepth);
+            float panGainR = 0.5f * (1.0f + modL[sample] * modulationDepth);
+
+            outputL[sample] = lowL + highL * panGainL + highR * (1.0f - panGainL) * 0.3f;
+            outputR[sample] = lowR + highR * panGainR + highL * (1.0f - panGainR) * 0.3f;
+        }
+    }
 
-            outputL = lowL + highL * panGainL + highR * (1.0f - panGainL) * 0.3f;
-            outputR = lowR + highR * panGainR + highL * (1.0f - panGainR) * 0.3f;
-            break;
+    // ============================================================
+    // ISOCHRONIC GATE - Rhythmic amplitude modulation
+    // ============================================================
+    else if constexpr (Mode == ProcessingMode::IsochronicGate) {
+        if (currentPulseShape == PulseShape::Sine) {
+            beatLfo.processBlock(modL, beatRamp, numSamples);
+            for (int sample = 0; sample < numSamples; ++sample)
+                modL[sample] = 0.5f * (1.0f + modL[sample]);
+        }
+        else {
+            isochronicPulse.processBlock(modL, beatRamp, numSamples);
         }
 
-                                        // ============================================================
-                                        // ISOCHRONIC GATE - Rhythmic amplitude modulation
-                                        // ============================================================
-        case ProcessingMode::IsochronicGate: {
-            float gate = 0.5f * (1.0f + std::sin(juce::MathConstants<float>::twoPi * beatHz * time));
-            gate = juce::jlimit(0.0f, 1.0f, gate * modulationDepth + (1.0f - modulationDepth));
+        for (int sample = 0; sample < numSamples; ++sample) {
+            float gate = juce::jlimit(0.0f, 1.0f, modL[sample] * modulationDepth + (1.0f - modulationDepth));
 
             // Apply sidechain if enabled
-            if (sidechainDepth > 0.01f) {
-                gate *= (1.0f - inputEnv * sidechainDepth);
-            }
+            if constexpr (WithSidechain)
+                gate *= 1.0f - envelopeRamp[sample] * sidechainDepth;
 
-            outputL = inputL * gate;
-            outputR = inputR * gate;
-            break;
+            outputL[sample] = inputL[sample] * gate;
+            outputR[sample] = inputR[sample] * gate;
         }
+    }
 
-                                           // ============================================================
-                                           // HEMI-SYNC - Full treatment
-                                           // ============================================================
-        case ProcessingMode::HemiSync: {
-            // 1. Phase-locked modulation
-            sharedPhase += beatHz / static_cast<float>(sampleRate);
-            if (sharedPhase >= 1.0f) sharedPhase -= 1.0f;
-
-            // 2. Hemispheric drift
-            driftPhase += (0.02f * hemiDrift) / static_cast<float>(sampleRate);
-            if (driftPhase >= 1.0f) driftPhase -= 1.0f;
+    // ============================================================
+    // HEMI-SYNC - Full treatment
+    // ============================================================
+    else if constexpr (Mode == ProcessingMode::HemiSync) {
+        // 1-2. Phase-locked modulation signals with hemispheric drift. The
+        // LFOs latch their offset once per control segment, so it is set per
+        // segment-sized run; it moves by < 1e-4 cycles in one. Without drift
+        // the last offset holds.
+        if constexpr (WithDrift) {
+            auto* driftRamp = controlBuffer.getWritePointer(DriftRamp);
+            driftLfo.processBlock(driftRamp, 0.02f * block.hemiDrift, numSamples);
+
+            for (int start = 0; start < numSamples; start += hemiControlInterval) {
+                auto count = juce::jmin(hemiControlInterval, numSamples - start);
+                driftOffset = driftRamp[start] * 0.15f;
+
+                hemiLeftLfo.setPhaseOffset(driftOffset);
+                hemiRightLfo.setPhaseOffset(-driftOffset);
+                hemiLeftLfo.processBlock(modL + start, beatRamp + start, count);
+                hemiRightLfo.processBlock(modR + start, beatRamp + start, count);
+            }
+        }
+        else {
+            hemiLeftLfo.setPhaseOffset(driftOffset);
+            hemiRightLfo.setPhaseOffset(-driftOffset);
+            hemiLeftLfo.processBlock(modL, beatRamp, numSamples);
+            hemiRightLfo.processBlock(modR, beatRamp, numSamples);
+        }
 
-            float drift = std::sin(driftPhase * juce::MathConstants<float>::twoPi) * 0.15f;
+        // Correlated noise for depth: a constant-power pair
+        auto* noiseL = controlBuffer.getWritePointer(LeftNoise);
+        auto* noiseR = controlBuffer.getWritePointer(RightNoise);
+        noiseGen.generateCorrelatedBlock(noiseL, noiseR, correlationAmount, numSamples);
 
-            // 3. Create modulation signals with drift
-            float modL = std::sin((sharedPhase + drift) * juce::MathConstants<float>::twoPi);
-            float modR = std::sin((sharedPhase - drift) * juce::MathConstants<float>::twoPi);
+        float amDepth = modulationDepth * 0.5f;
 
-            // 4. Apply amplitude modulation
-            float amDepth = modulationDepth * 0.5f;
-            float gateL = 0.5f * (1.0f + modL * amDepth) + 0.5f * (1.0f - amDepth);
-            float gateR = 0.5f * (1.0f + modR * amDepth) + 0.5f * (1.0f - amDepth);
+        for (int sample = 0; sample < numSamples; ++sample) {
+            // 3. Apply amplitude modulation
+            float gateL = 0.5f * (1.0f + modL[sample] * amDepth) + 0.5f * (1.0f - amDepth);
+            float gateR = 0.5f * (1.0f + modR[sample] * amDepth) + 0.5f * (1.0f - amDepth);
 
             // Apply sidechain
-            if (sidechainDepth > 0.01f) {
-                float scMod = 1.0f - inputEnv * sidechainDepth;
+            if constexpr (WithSidechain) {
+                float scMod = 1.0f - envelopeRamp[sample] * sidechainDepth;
                 gateL *= scMod;
                 gateR *= scMod;
             }
 
-            // 5. Process through spectral asymmetry filters
-            outputL = leftFilter.process(inputL * gateL);
-            outputR = rightFilter.process(inputR * gateR);
+            outputL[sample] = inputL[sample] * gateL;
+            outputR[sample] = inputR[sample] * gateR;
+        }
 
-            // 6. Add correlated noise for depth
-            float sharedNoise = noiseGen.generatePink() * 0.02f;
-            float independentNoiseL = noiseGen.generatePink() * 0.02f;
-            float independentNoiseR = noiseGen.generatePink() * 0.02f;
+        // 4. Process through spectral asymmetry filters, both channels in one register
+        float* wet[] = { outputL, outputR };
+        spectralFilters.processBlock(wet, wet, 2, numSamples);
 
-            outputL += sharedNoise * correlationAmount + independentNoiseL * (1.0f - correlationAmount);
-            outputR += sharedNoise * correlationAmount + independentNoiseR * (1.0f - correlationAmount);
-            break;
+        // 5. Add correlated noise for depth
+        for (int sample = 0; sample < numSamples; ++sample) {
+            outputL[sample] += noiseL[sample] * 0.02f;
+            outputR[sample] += noiseR[sample] * 0.02f;
         }
+    }
 
-                                     // ============================================================
-                                     // FREQUENCY SHIFT - Subtle pitch modulation
-                                     // ============================================================
-        case ProcessingMode::FrequencyShift: {
-            // Simple vibrato effect at brainwave rate
-            float vibrato = std::sin(juce::MathConstants<float>::twoPi * beatHz * time) * modulationDepth * 0.02f;
+    // ============================================================
+    // FREQUENCY SHIFT - Subtle pitch modulation
+    // ============================================================
+    else if constexpr (Mode == ProcessingMode::FrequencyShift) {
+        // Simple vibrato effect at brainwave rate
+        beatLfo.processBlock(modL, beatRamp, numSamples);
 
-            // This is a simplified version - true frequency shifting would need phase vocoder
-            // For now, we'll use a subtle tremolo + phase modulation
-            float mod = 1.0f + vibrato;
+        // This is a simplified version - true frequency shifting would need phase vocoder
+        // For now, we'll use a subtle tremolo + phase modulation
+        for (int sample = 0; sample < numSamples; ++sample) {
+            float mod = 1.0f + modL[sample] * modulationDepth * 0.02f;
 
-            outputL = inputL * mod;
-            outputR = inputR * mod;
-            break;
+            outputL[sample] = inputL[sample] * mod;
+            outputR[sample] = inputR[sample] * mod;
         }
+    }
 
-                                           // ============================================================
-                                           // HYBRID - Combination of techniques
-                                           // ============================================================
-        case ProcessingMode::Hybrid: {
-            // Combine isochronic gate + binaural pan
-            float gate = 0.5f * (1.0f + std::sin(juce::MathConstants<float>::twoPi * beatHz * time));
-            gate = juce::jlimit(0.0f, 1.0f, gate * modulationDepth * 0.5f + 0.5f);
+    // ============================================================
+    // HYBRID - Combination of techniques
+    // ============================================================
+    else if constexpr (Mode == ProcessingMode::Hybrid) {
+        // Combine isochronic gate + binaural pan
+        auto* halfBeatRamp = controlBuffer.getWritePointer(HalfBeatHzRamp);
+        for (int sample = 0; sample < numSamples; ++sample)
+            halfBeatRamp[sample] = beatRamp[sample] * 0.5f;
 
-            float pan = std::sin(juce::MathConstants<float>::twoPi * beatHz * time * 0.5f);
-            float panGainL = 0.5f * (1.0f - pan * 0.3f);
-            float panGainR = 0.5f * (1.0f + pan * 0.3f);
+        beatLfo.processBlock(modL, beatRamp, numSamples);
+        halfBeatLfo.processBlock(modR, halfBeatRamp, numSamples);
 
-            outputL = inputL * gate * panGainL + inputR * gate * (1.0f - panGainL) * 0.2f;
-            outputR = inputR * gate * panGainR + inputL * gate * (1.0f - panGainR) * 0.2f;
-            break;
-        }
-        }
+        for (int sample = 0; sample < numSamples; ++sample) {
+            float gate = 0.5f * (1.0f + modL[sample]);
+            gate = juce::jlimit(0.0f, 1.0f, gate * modulationDepth * 0.5f + 0.5f);
 
-        // Add carrier tone if enabled
-        if (carrierAmount > 0.01f) {
-            float carrierSample = carrierOsc.process();
-            outputL += carrierSample * carrierAmount * 0.3f;
-            outputR += carrierSample * carrierAmount * 0.3f;
+            float panGainL = 0.5f * (1.0f - modR[sample] * 0.3f);
+            float panGainR = 0.5f * (1.0f + modR[sample] * 0.3f);
+
+            outputL[sample] = inputL[sample] * gate * panGainL + inputR[sample] * gate * (1.0f - panGainL) * 0.2f;
+            outputR[sample] = inputR[sample] * gate * panGainR + inputL[sample] * gate * (1.0f - panGainR) * 0.2f;
         }
+    }
+}
 
-        // Stereo width adjustment
-        float mid = (outputL + outputR) * 0.5f;
-        float side = (outputL - outputR) * 0.5f;
+// A tier's flattened wrapper; builds without dispatch fill every tier with the plain kernel
+template <SimdTier Tier, ProcessingMode Mode, bool WithSidechain, bool WithDrift>
+constexpr auto BrainwaveEntrainmentFXAudioProcessor::kernelFor() -> ModeKernel {
+#if BRAINWAVE_SIMD_DISPATCH
+    if constexpr (Tier == SimdTier::Avx512)
+        return &BrainwaveEntrainmentFXAudioProcessor::renderModeAvx512<Mode, WithSidechain, WithDrift>;
+    if constexpr (Tier == SimdTier::Avx2)
+        return &BrainwaveEntrainmentFXAudioProcessor::renderModeAvx2<Mode, WithSidechain, WithDrift>;
+#endif
+    return &BrainwaveEntrainmentFXAudioProcessor::renderMode<Mode, WithSidechain, WithDrift>;
+}
 
-        outputL = mid + side * width;
-        outputR = mid - side * width;
+// Sidechain only applies to the gate modes and drift only to Hemi-Sync; the
+// other modes share one kernel for those flags
+template <SimdTier Tier, ProcessingMode Mode>
+constexpr auto BrainwaveEntrainmentFXAudioProcessor::kernelsForMode()
+    -> std::array<ModeKernel, NumKernelVariants> {
+    constexpr bool hasSidechain = Mode == ProcessingMode::IsochronicGate || Mode == ProcessingMode::HemiSync;
+    constexpr bool hasDrift = Mode == ProcessingMode::HemiSync;
+
+    return { {
+        kernelFor<Tier, Mode, false, false>(),
+        kernelFor<Tier, Mode, hasSidechain, false>(),
+        kernelFor<Tier, Mode, false, hasDrift>(),
+        kernelFor<Tier, Mode, hasSidechain, hasDrift>()
+    } };
+}
 
-        // Wet/dry mix
-        leftChannel[sample] = dryBuffer.getSample(0, sample) * (1.0f - wet) + outputL * wet;
-        rightChannel[sample] = dryBuffer.getSample(1, sample) * (1.0f - wet) + outputR * wet;
-    }
+template <SimdTier Tier>
+constexpr auto BrainwaveEntrainmentFXAudioProcessor::kernelsForTier() -> KernelTable {
+    return { {
+        kernelsForMode<Tier, ProcessingMode::BinauralPan>(),
+        kernelsForMode<Tier, ProcessingMode::IsochronicGate>(),
+        kernelsForMode<Tier, ProcessingMode::HemiSync>(),
+        kernelsForMode<Tier, ProcessingMode::FrequencyShift>(),
+        kernelsForMode<Tier, ProcessingMode::Hybrid>()
+    } };
 }
 
+// Indexed by SimdTier, ProcessingMode, then KernelFlags
+const std::array<BrainwaveEntrainmentFXAudioProcessor::KernelTable, SimdDispatch::numTiers>
+BrainwaveEntrainmentFXAudioProcessor::modeKernels = { {
+    kernelsForTier<SimdTier::Baseline>(),
+    kernelsForTier<SimdTier::Avx2>(),
+    kernelsForTier<SimdTier::Avx512>()
+} };
+
 // ============================================================================
 // PARAMETER HANDLING
 // ============================================================================
 
+// Called on the host's notification thread: hand the change to the audio thread
 void BrainwaveEntrainmentFXAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue) {
-    if (parameterID == "brainwave_frequency") {
-        currentFrequency = static_cast<BrainwaveFrequency>(static_cast<int>(newValue));
-        updateFrequencies();
-    }
-    else if (parameterID == "processing_mode") {
-        currentMode = static_cast<ProcessingMode>(static_cast<int>(newValue));
+    // Only the editor reads this; the audio thread takes bypass from its snapshot
+    if (parameterID == "bypass") {
+        processingActive = newValue < 0.5f;
+        return;
     }
-    else if (parameterID == "carrier_frequency") {
-        carrierHz.setTargetValue(newValue);
+
+    for (int i = 0; i < numParameterTargets; ++i) {
+        auto target = static_cast<ParameterTarget>(i);
+
+        if (parameterID == getParameterId(target)) {
+            commandQueue.push({ target, newValue });
+            return;
+        }
     }
-    else if (parameterID == "beat_offset") {
-        updateFrequencies();
+}
+
+const char* BrainwaveEntrainmentFXAudioProcessor::getParameterId(ParameterTarget target) {
+    switch (target) {
+    case ParameterTarget::ProcessingMode:   return "processing_mode";
+    case ParameterTarget::CarrierFrequency: return "carrier_frequency";
+    case ParameterTarget::WetDryMix:        return "wet_dry_mix";
+    case ParameterTarget::CarrierBlend:     return "carrier_blend";
+    case ParameterTarget::StereoWidth:      return "stereo_width";
+    case ParameterTarget::NoiseColour:      return "noise_colour";
+    case ParameterTarget::IsochronicShape:  return "isochronic_shape";
+    case ParameterTarget::IsochronicDuty:   return "isochronic_duty";
+    case ParameterTarget::IsochronicEdge:   return "isochronic_edge";
+    default: break;
     }
-    else if (parameterID == "wet_dry_mix") {
+
+    return "";
+}
+
+// Audio thread (or prepareToPlay, while nothing is rendering)
+void BrainwaveEntrainmentFXAudioProcessor::applyCommand(const ParameterCommand& command) {
+    auto newValue = command.value;
+
+    switch (command.target) {
+    case ParameterTarget::ProcessingMode:
+        currentMode = static_cast<ProcessingMode>(static_cast<int>(newValue));
+        break;
+
+    case ParameterTarget::CarrierFrequency:
+        carrierHz.setTargetValue(newValue);
+        break;
+
+    case ParameterTarget::WetDryMix:
         wetDryMix.setTargetValue(newValue);
-    }
-    else if (parameterID == "carrier_blend") {
+        break;
+
+    case ParameterTarget::CarrierBlend:
         carrierBlend.setTargetValue(newValue);
-    }
-    else if (parameterID == "stereo_width") {
+        break;
+
+    case ParameterTarget::StereoWidth:
         stereoWidth.setTargetValue(newValue);
-    }
-    else if (parameterID == "bypass") {
-        processingActive = newValue < 0.5f;
+        break;
+
+    case ParameterTarget::NoiseColour:
+        noiseGen.setColour(static_cast<NoiseColour>(static_cast<int>(newValue)));
+        break;
+
+    case ParameterTarget::IsochronicShape:
+        currentPulseShape = static_cast<PulseShape>(static_cast<int>(newValue));
+        isochronicPulse.setShape(currentPulseShape);
+        break;
+
+    case ParameterTarget::IsochronicDuty:
+        isochronicPulse.setDuty(newValue);
+        break;
+
+    case ParameterTarget::IsochronicEdge:
+        isochronicPulse.setEdgeTime(newValue * 0.001f);
+        break;
+
+    default:
+        break;
     }
 }
 
-void BrainwaveEntrainmentFXAudioProcessor::updateFrequencies() {
-    // Get base brainwave frequency
-    float baseHz = 10.0f;
-    switch (currentFrequency) {
-    case BrainwaveFrequency::Delta: baseHz = 2.0f; break;
-    case BrainwaveFrequency::Theta: baseHz = 6.0f; break;
-    case BrainwaveFrequency::Alpha: baseHz = 10.0f; break;
-    case BrainwaveFrequency::Beta: baseHz = 20.0f; break;
-    case BrainwaveFrequency::Gamma: baseHz = 40.0f; break;
-    }
+// Every listener-driven setting straight from its parameter, for when the
+// queue can't be trusted to hold every change
+void BrainwaveEntrainmentFXAudioProcessor::applyAllParameters() {
+    for (int i = 0; i < numParameterTargets; ++i)
+        applyCommand({ static_cast<ParameterTarget>(i), targetValues[static_cast<size_t>(i)]->load() });
+}
+
+BrainwaveEntrainmentFXAudioProcessor::ParamSnapshot BrainwaveEntrainmentFXAudioProcessor::takeSnapshot() const {
+    ParamSnapshot snapshot;
 
-    // Add user offset
-    float beatOffset = parameters.getRawParameterValue("beat_offset")->load();
-    float finalBeatHz = juce::jlimit(0.5f, 100.0f, baseHz + beatOffset);
+    auto band = static_cast<BrainwaveFrequency>(static_cast<int>(paramPointers.brainwaveFrequency->load()));
 
-    currentBeatHz.setTargetValue(finalBeatHz);
+    snapshot.bypass = paramPointers.bypass->load() > 0.5f;
+    snapshot.beatHz = juce::jlimit(0.5f, 100.0f, getBandHz(band) + paramPointers.beatOffset->load());
+    snapshot.modulationDepth = paramPointers.modulationDepth->load();
+    snapshot.sidechainDepth = paramPointers.sidechainDepth->load();
+    snapshot.hemiDrift = paramPointers.hemiDrift->load();
+    snapshot.hemiCorrelation = paramPointers.hemiCorrelation->load();
+
+    return snapshot;
+}
+
+float BrainwaveEntrainmentFXAudioProcessor::getBandHz(BrainwaveFrequency band) {
+    switch (band) {
+    case BrainwaveFrequency::Delta: return 2.0f;
+    case BrainwaveFrequency::Theta: return 6.0f;
+    case BrainwaveFrequency::Alpha: return 10.0f;
+    case BrainwaveFrequency::Beta: return 20.0f;
+    case BrainwaveFrequency::Gamma: return 40.0f;
+    }
+
+    return 10.0f;
 }
 
 // ============================================================================
@@ -405,6 +764,25 @@ BrainwaveEntrainmentFXAudioProcessor::createParameterLayout() {
         juce::AudioProcessorParameter::genericParameter,
         [](float value, int) { return juce::String(static_cast<int>(value * 100.0f)) + "%"; }));
 
+    // Isochronic Gate pulse shape
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "isochronic_shape", "Pulse Shape",
+        juce::StringArray{ "Sine", "Raised Cosine", "Trapezoid", "Exponential", "Band-Limited Square" }, 0));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        "isochronic_duty", "Pulse Duty",
+        juce::NormalisableRange<float>(0.05f, 0.95f, 0.01f), 0.5f,
+        juce::String(),
+        juce::AudioProcessorParameter::genericParameter,
+        [](float value, int) { return juce::String(static_cast<int>(value * 100.0f)) + "%"; }));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        "isochronic_edge", "Pulse Edge",
+        juce::NormalisableRange<float>(1.0f, 100.0f, 0.1f), 10.0f,
+        juce::String(),
+        juce::AudioProcessorParameter::genericParameter,
+        [](float value, int) { return juce::String(value, 1) + " ms"; }));
+
     // Hemi-Sync specific
     layout.add(std::make_unique<juce::AudioParameterFloat>(
         "hemisync_correlation", "Noise Correlation",
@@ -420,6 +798,10 @@ BrainwaveEntrainmentFXAudioProcessor::createParameterLayout() {
         juce::AudioProcessorParameter::genericParameter,
         [](float value, int) { return juce::String(static_cast<int>(value * 100.0f)) + "%"; }));
 
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "noise_colour", "Noise Colour",
+        juce::StringArray{ "White", "Pink", "Brown", "Blue", "Violet", "Grey" }, 1));
+
     return layout;
 }
 
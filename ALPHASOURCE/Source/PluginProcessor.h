@@ -1,11 +1,35 @@
 #pragma once
 #include <JuceHeader.h>
+#include <array>
 #include <random>
 #include <vector>
+#include <type_traits>
 #include <cmath>
+#include "../../Common/FastMath.h"
+#include "../../Common/PhaseAccumulator.h"
+#include "../../Common/FastRandom.h"
+#include "../../Common/NoiseGenerator.h"
+#include "../../Common/BiquadLanes.h"
+#include "../../Common/ControlRateLfo.h"
+#include "../../Common/IsochronicPulse.h"
+#include "../../Common/LevelDetector.h"
+#include "../../Common/CommandQueue.h"
+#include "../../Common/MeterRing.h"
+#include "../../Common/AllocationCheck.h"
+#include "../../Common/SimdDispatch.h"
 
 // ============================================================================
-// SHARED DSP CLASSES (from synth version)
+// FAST MATH PRECISION PER CALL SITE
+// ============================================================================
+
+namespace MathTier {
+    constexpr auto oscillator = FastMath::Precision::High;         // audible carriers
+    constexpr auto amGate = FastMath::Precision::Standard;         // beat-rate gain, pan and vibrato curves
+    constexpr auto driftLfo = FastMath::Precision::Draft;          // sub-Hz phase wobble
+}
+
+// ============================================================================
+// ENUMS AND TYPES
 // ============================================================================
 
 enum class BrainwaveFrequency {
@@ -40,8 +64,7 @@ enum class Waveform {
 class BrainwaveOscillator {
 public:
     BrainwaveOscillator()
-        : randomGenerator(std::random_device{}()),
-        randomDistribution(-1.0f, 1.0f) {
+        : random(std::random_device{}()) {
     }
 
     void setSampleRate(double sr) {
@@ -59,41 +82,41 @@ public:
     }
 
     void setPhase(float ph) {
-        phase = ph;
+        phase = Phase::fromCycles(ph);
     }
 
     void reset() {
-        phase = 0.0f;
+        phase = 0;
     }
 
     float process() {
         float sample = 0.0f;
+        auto cycles = Phase::toCycles(phase);
 
         switch (currentWaveform) {
         case Waveform::Sine:
-            sample = std::sin(phase * juce::MathConstants<float>::twoPi);
+            sample = FastMath::sinPhase<MathTier::oscillator>(phase);
             break;
         case Waveform::Triangle:
-            sample = 2.0f * std::abs(2.0f * (phase - 0.5f)) - 1.0f;
+            sample = 2.0f * std::abs(2.0f * (cycles - 0.5f)) - 1.0f;
             break;
         case Waveform::Sawtooth:
-            sample = 2.0f * phase - 1.0f;
+            sample = 2.0f * cycles - 1.0f;
             break;
         case Waveform::Square:
-            sample = phase < 0.5f ? 1.0f : -1.0f;
+            sample = phase < Phase::halfCycle ? 1.0f : -1.0f;
             break;
         case Waveform::Pulse:
-            sample = (phase < 0.25f) ? 1.0f : -1.0f;
+            sample = (phase < Phase::quarterCycle) ? 1.0f : -1.0f;
             break;
         case Waveform::Noise:
-            sample = randomDistribution(randomGenerator);
+            sample = random.nextFloat();
             break;
         default:
-            sample = std::sin(phase * juce::MathConstants<float>::twoPi);
+            sample = FastMath::sinPhase<MathTier::oscillator>(phase);
         }
 
         phase += phaseIncrement;
-        if (phase >= 1.0f) phase -= 1.0f;
 
         return sample;
     }
@@ -102,167 +125,14 @@ private:
     Waveform currentWaveform = Waveform::Sine;
     double sampleRate = 44100.0;
     float frequency = 440.0f;
-    float phase = 0.0f;
-    float phaseIncrement = 0.0f;
+    Phase::Type phase = 0;
+    Phase::Type phaseIncrement = 0;
 
-    std::mt19937 randomGenerator;
-    std::uniform_real_distribution<float> randomDistribution;
+    FastRandom random;
 
     void updateIncrement() {
-        phaseIncrement = frequency / static_cast<float>(sampleRate);
-    }
-};
-
-// ============================================================================
-// NOISE GENERATOR
-// ============================================================================
-
-class NoiseGenerator {
-public:
-    NoiseGenerator()
-        : randomEngine(std::random_device{}()),
-        distribution(-1.0f, 1.0f) {
-        for (int i = 0; i < 7; ++i)
-            pinkState[i] = 0.0f;
-    }
-
-    float generateWhite() {
-        return distribution(randomEngine);
-    }
-
-    float generatePink() {
-        float white = distribution(randomEngine);
-
-        pinkState[0] = 0.99886f * pinkState[0] + white * 0.0555179f;
-        pinkState[1] = 0.99332f * pinkState[1] + white * 0.0750759f;
-        pinkState[2] = 0.96900f * pinkState[2] + white * 0.1538520f;
-        pinkState[3] = 0.86650f * pinkState[3] + white * 0.3104856f;
-        pinkState[4] = 0.55000f * pinkState[4] + white * 0.5329522f;
-        pinkState[5] = -0.7616f * pinkState[5] - white * 0.0168980f;
-
-        float pink = pinkState[0] + pinkState[1] + pinkState[2] +
-            pinkState[3] + pinkState[4] + pinkState[5] +
-            pinkState[6] + white * 0.5362f;
-        pinkState[6] = white * 0.115926f;
-
-        return pink * 0.11f;
-    }
-
-private:
-    std::mt19937 randomEngine;
-    std::uniform_real_distribution<float> distribution;
-    float pinkState[7];
-};
-
-// ============================================================================
-// BIQUAD FILTER
-// ============================================================================
-
-class SimpleBiquad {
-public:
-    void setLowpass(double sampleRate, float cutoffHz, float Q = 0.707f) {
-        float w0 = juce::MathConstants<float>::twoPi * cutoffHz / static_cast<float>(sampleRate);
-        float cosw0 = std::cos(w0);
-        float sinw0 = std::sin(w0);
-        float alpha = sinw0 / (2.0f * Q);
-
-        float b0_temp = (1.0f - cosw0) / 2.0f;
-        float b1_temp = 1.0f - cosw0;
-        float b2_temp = (1.0f - cosw0) / 2.0f;
-        float a0_temp = 1.0f + alpha;
-        float a1_temp = -2.0f * cosw0;
-        float a2_temp = 1.0f - alpha;
-
-        b0 = b0_temp / a0_temp;
-        b1 = b1_temp / a0_temp;
-        b2 = b2_temp / a0_temp;
-        a1 = a1_temp / a0_temp;
-        a2 = a2_temp / a0_temp;
-    }
-
-    void setHighpass(double sampleRate, float cutoffHz, float Q = 0.707f) {
-        float w0 = juce::MathConstants<float>::twoPi * cutoffHz / static_cast<float>(sampleRate);
-        float cosw0 = std::cos(w0);
-        float sinw0 = std::sin(w0);
-        float alpha = sinw0 / (2.0f * Q);
-
-        float b0_temp = (1.0f + cosw0) / 2.0f;
-        float b1_temp = -(1.0f + cosw0);
-        float b2_temp = (1.0f + cosw0) / 2.0f;
-        float a0_temp = 1.0f + alpha;
-        float a1_temp = -2.0f * cosw0;
-        float a2_temp = 1.0f - alpha;
-
-        b0 = b0_temp / a0_temp;
-        b1 = b1_temp / a0_temp;
-        b2 = b2_temp / a0_temp;
-        a1 = a1_temp / a0_temp;
-        a2 = a2_temp / a0_temp;
-    }
-
-    float process(float input) {
-        float output = b0 * input + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
-
-        x2 = x1;
-        x1 = input;
-        y2 = y1;
-        y1 = output;
-
-        return output;
-    }
-
-    void reset() {
-        x1 = x2 = y1 = y2 = 0.0f;
-    }
-
-private:
-    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f;
-    float a1 = 0.0f, a2 = 0.0f;
-    float x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f;
-};
-
-// ============================================================================
-// ENVELOPE FOLLOWER (for sidechain)
-// ============================================================================
-
-class EnvelopeFollower {
-public:
-    void setSampleRate(double sr) {
-        sampleRate = sr;
-        setAttackTime(10.0f);
-        setReleaseTime(100.0f);
-    }
-
-    void setAttackTime(float ms) {
-        attackCoeff = std::exp(-1.0f / (static_cast<float>(sampleRate) * ms * 0.001f));
-    }
-
-    void setReleaseTime(float ms) {
-        releaseCoeff = std::exp(-1.0f / (static_cast<float>(sampleRate) * ms * 0.001f));
-    }
-
-    float process(float input) {
-        float inputAbs = std::abs(input);
-
-        if (inputAbs > envelope) {
-            envelope = attackCoeff * (envelope - inputAbs) + inputAbs;
-        }
-        else {
-            envelope = releaseCoeff * (envelope - inputAbs) + inputAbs;
-        }
-
-        return envelope;
-    }
-
-    void reset() {
-        envelope = 0.0f;
+        phaseIncrement = Phase::fromIncrement(frequency / static_cast<float>(sampleRate));
     }
-
-private:
-    double sampleRate = 44100.0;
-    float attackCoeff = 0.0f;
-    float releaseCoeff = 0.0f;
-    float envelope = 0.0f;
 };
 
 // ============================================================================
@@ -278,6 +148,8 @@ public:
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -300,36 +172,154 @@ public:
 
     juce::AudioProcessorValueTreeState& getValueTreeState() { return parameters; }
 
-    bool isActive() const { return processingActive; }
+    bool isActive() const { return processingActive.load(); }
     float getCurrentBeatFrequency() const { return currentBeatHz.getCurrentValue(); }
-    float getCurrentEnvelope() const { return currentEnvelope; }
+
+    // Monitoring: one frame per block, drained by the editor
+    using MeterQueue = MeterRing<256>;
+    MeterQueue& getMeterRing() { return meterRing; }
 
 private:
     void parameterChanged(const juce::String& parameterID, float newValue) override;
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
-    void updateFrequencies();
-    void processAudio(juce::AudioBuffer<float>& buffer);
+    // Parameter values for one block, gathered at block start from atomics
+    // resolved once at construction, plus the beat rate derived from them
+    struct ParamSnapshot {
+        bool bypass = false;
+        float beatHz = 10.0f;               // band + beat offset
+        float modulationDepth = 0.5f;
+        float sidechainDepth = 0.0f;
+        float hemiDrift = 0.0f;
+        float hemiCorrelation = 0.7f;
+    };
+
+    struct ParameterPointers {
+        std::atomic<float>* bypass = nullptr;
+        std::atomic<float>* brainwaveFrequency = nullptr;
+        std::atomic<float>* beatOffset = nullptr;
+        std::atomic<float>* modulationDepth = nullptr;
+        std::atomic<float>* sidechainDepth = nullptr;
+        std::atomic<float>* hemiDrift = nullptr;
+        std::atomic<float>* hemiCorrelation = nullptr;
+    };
+
+    // Settings driven by parameter listeners. Listeners only enqueue; the
+    // audio thread applies them, so oscillator and smoother state is never
+    // touched from another thread.
+    enum class ParameterTarget {
+        ProcessingMode = 0,
+        CarrierFrequency,
+        WetDryMix,
+        CarrierBlend,
+        StereoWidth,
+        NoiseColour,
+        IsochronicShape,
+        IsochronicDuty,
+        IsochronicEdge,
+        NumTargets
+    };
+
+    struct ParameterCommand {
+        ParameterTarget target = ParameterTarget::NumTargets;
+        float value = 0.0f;
+    };
+
+    static constexpr int numParameterTargets = static_cast<int>(ParameterTarget::NumTargets);
+
+    static const char* getParameterId(ParameterTarget target);
+    void applyCommand(const ParameterCommand& command);
+    void applyAllParameters();
+
+    ParamSnapshot takeSnapshot() const;
+    static float getBandHz(BrainwaveFrequency band);
+
+    template <typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer);
+
+    template <typename SampleType>
+    void processAudio(juce::AudioBuffer<SampleType>& buffer, const ParamSnapshot& snapshot);
+
+    // Adds the carrier to the wet signal, applies stereo width and blends it
+    // into the buffer by the wet ramp
+    template <typename SampleType>
+    void mixWetSignal(juce::AudioBuffer<SampleType>& buffer, bool carrierOn);
+
+#if BRAINWAVE_SIMD_DISPATCH
+    template <typename SampleType>
+    BRAINWAVE_TARGET_AVX2 void mixWetSignalAvx2(juce::AudioBuffer<SampleType>& buffer, bool carrierOn) {
+        mixWetSignal(buffer, carrierOn);
+    }
+
+    template <typename SampleType>
+    BRAINWAVE_TARGET_AVX512 void mixWetSignalAvx512(juce::AudioBuffer<SampleType>& buffer, bool carrierOn) {
+        mixWetSignal(buffer, carrierOn);
+    }
+#endif
+
+    // Block-constant settings handed to the mode kernel
+    struct ModeBlock {
+        const float* inputL = nullptr;
+        const float* inputR = nullptr;
+        float modulationDepth = 0.0f;
+        float sidechainDepth = 0.0f;
+        float hemiDrift = 0.0f;
+        int numSamples = 0;
+    };
+
+    // Renders one processing mode's wet signal into WetLeft / WetRight.
+    // Sidechain and drift are compile-time flags, so the sample loops carry
+    // no mode or feature tests; the kernel is picked once per block from
+    // modeKernels, for the SIMD tier chosen in prepareToPlay.
+    template <ProcessingMode Mode, bool WithSidechain, bool WithDrift>
+    void renderMode(const ModeBlock& block);
+
+#if BRAINWAVE_SIMD_DISPATCH
+    template <ProcessingMode Mode, bool WithSidechain, bool WithDrift>
+    BRAINWAVE_TARGET_AVX2 void renderModeAvx2(const ModeBlock& block) {
+        renderMode<Mode, WithSidechain, WithDrift>(block);
+    }
+
+    template <ProcessingMode Mode, bool WithSidechain, bool WithDrift>
+    BRAINWAVE_TARGET_AVX512 void renderModeAvx512(const ModeBlock& block) {
+        renderMode<Mode, WithSidechain, WithDrift>(block);
+    }
+#endif
+
+    using ModeKernel = void (BrainwaveEntrainmentFXAudioProcessor::*)(const ModeBlock&);
+    enum KernelFlags { SidechainOn = 1, DriftOn = 2, NumKernelVariants = 4 };
+
+    static constexpr size_t numProcessingModes = 5;
+    using KernelTable = std::array<std::array<ModeKernel, NumKernelVariants>, numProcessingModes>;
+
+    template <SimdTier Tier, ProcessingMode Mode, bool WithSidechain, bool WithDrift>
+    static constexpr ModeKernel kernelFor();
+
+    template <SimdTier Tier, ProcessingMode Mode>
+    static constexpr std::array<ModeKernel, NumKernelVariants> kernelsForMode();
+
+    template <SimdTier Tier>
+    static constexpr KernelTable kernelsForTier();
+
+    static const std::array<KernelTable, SimdDispatch::numTiers> modeKernels;
 
     // DSP Components
     BrainwaveOscillator carrierOsc;
     NoiseGenerator noiseGen;
-    SimpleBiquad leftFilter;
-    SimpleBiquad rightFilter;
-    SimpleBiquad leftSplitLow;
-    SimpleBiquad leftSplitHigh;
-    SimpleBiquad rightSplitLow;
-    SimpleBiquad rightSplitHigh;
-    EnvelopeFollower envelopeFollower;
+    BiquadLanes spectralFilters;        // lane 0 left, lane 1 right
+    BiquadLanes crossover;              // low left, high left, low right, high right
+    LevelDetector envelopeFollower;     // sidechain, peak
 
     // Parameters
     juce::AudioProcessorValueTreeState parameters;
+    ParameterPointers paramPointers;
+    std::array<std::atomic<float>*, numParameterTargets> targetValues{};
+    CommandQueue<ParameterCommand, 256> commandQueue;
 
     // State
     double sampleRate = 44100.0;
-    bool processingActive = true;
-
-    juce::int64 samplesProcessed = 0;
+    SimdTier simdTier = SimdTier::Baseline;
+    std::atomic<bool> processingActive{ true };     // for the editor
 
     // Smoothed values
     juce::SmoothedValue<float> currentBeatHz{ 10.0f };
@@ -338,15 +328,56 @@ private:
     juce::SmoothedValue<float> carrierBlend{ 0.0f };
     juce::SmoothedValue<float> stereoWidth{ 1.0f };
 
-    // Hemi-Sync state
-    float sharedPhase = 0.0f;
-    float driftPhase = 0.0f;
+    // Beat-rate curves, phase continuous across blocks: the pan, gate and
+    // vibrato curve, and the half-rate Hybrid pan
+    ControlRateLfo<MathTier::amGate> beatLfo;
+    ControlRateLfo<MathTier::amGate> halfBeatLfo;
+
+    // Shaped Isochronic Gate pulses; PulseShape::Sine uses beatLfo instead
+    IsochronicPulse isochronicPulse;
+
+    // Hemi-Sync state: left/right modulators are offset by +/- the drift
+    ControlRateLfo<MathTier::oscillator> hemiLeftLfo;
+    ControlRateLfo<MathTier::oscillator> hemiRightLfo;
+    static constexpr int hemiControlInterval = 32;
+    ControlRateLfo<MathTier::driftLfo> driftLfo;
+    float driftOffset = 0.0f;       // held while drift is off
     float correlationAmount = 0.7f;
-    float currentEnvelope = 0.0f;
+
+    // Monitoring
+    MeterQueue meterRing;
+    MeterAccumulator blockMeters;       // the chunks of the current block
+
+    // Host blocks are processed in chunks of at most this many samples, so the
+    // scratch buffer below is sized once in prepareToPlay
+    static constexpr int processingChunkSize = 64;
+
+    // Per-sample signals rendered ahead of the sample loop, sized in prepareToPlay
+    enum ControlChannel {
+        InputLeft = 0,      // float copy of a double-precision input
+        InputRight,
+        LeftNoise,
+        RightNoise,
+        InputEnvelope,
+        BeatHzRamp,
+        HalfBeatHzRamp,
+        WetRamp,
+        CarrierAmountRamp,
+        WidthRamp,
+        DriftRamp,
+        LeftModulator,
+        RightModulator,
+        WetLeft,
+        WetRight,
+        HighLeft,           // Binaural Pan crossover bands above 500 Hz
+        HighRight,
+        NumControlChannels
+    };
+    juce::AudioBuffer<float> controlBuffer;
 
     // Current settings
     ProcessingMode currentMode = ProcessingMode::HemiSync;
-    BrainwaveFrequency currentFrequency = BrainwaveFrequency::Alpha;
+    PulseShape currentPulseShape = PulseShape::Sine;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BrainwaveEntrainmentFXAudioProcessor)
 };
\ No newline at end of file
@@ -0,0 +1,279 @@
+// ============================================================================
+// HEADLESS DSP BENCHMARK
+// ============================================================================
+//
+// Drives one of the plugin processors with synthetic input for every
+// combination of its mode / waveform / operation-mode choices and a range of
+// block sizes, and prints the timings as JSON.
+//
+// The processor is created through createPluginFilter() and configured purely
+// through its parameters, so the same file works against any of the three
+// plugin trees. Build it as a JUCE console application that also compiles the
+// PluginProcessor.cpp / PluginEditor.cpp of the tree being measured (Source,
+// ALPHASOURCE or GATEWAYv1) with that tree's JucePlugin_Name defined.
+//
+// Usage:
+//   BrainwaveBenchmark [--sample-rate 48000] [--seconds 1.0]
+//                      [--min-block 16] [--max-block 4096]
+//                      [--set param_id=value]... [--output results.json]
+//                      [--simd-tier sse2|avx2|avx512]
+//
+// --simd-tier sets BRAINWAVE_SIMD_TIER before the processor is prepared, so
+// the kernel tiers of Source and ALPHASOURCE can be compared; an unsupported
+// tier falls back to the best one. GATEWAYv1 has no tiers and ignores it.
+//
+// Output per run: ns/sample (per stereo frame), realtime factor (audio time /
+// wall time) and TSC cycles/sample on x86 targets.
+
+#include <JuceHeader.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define BRAINWAVE_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BRAINWAVE_HAS_TSC 1
+#else
+#define BRAINWAVE_HAS_TSC 0
+#endif
+
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter();
+
+namespace {
+
+// Choice parameters swept by the benchmark, in output order. Any that the
+// processor does not have are skipped.
+const char* const sweptParameterIDs[] = {
+    "entrainment_mode",   // Source, GATEWAYv1
+    "processing_mode",    // ALPHASOURCE
+    "waveform",
+    "operation_mode"
+};
+
+struct SweepAxis {
+    juce::String id;
+    juce::AudioParameterChoice* parameter = nullptr;
+};
+
+struct BenchmarkSettings {
+    double sampleRate = 48000.0;
+    double secondsPerRun = 1.0;
+    int minBlockSize = 16;
+    int maxBlockSize = 4096;
+    juce::StringArray overrides;
+    juce::String outputFile;
+    juce::String simdTier;          // empty: the processor picks
+};
+
+struct RunResult {
+    double nsPerSample = 0.0;
+    double realtimeFactor = 0.0;
+    double cyclesPerSample = -1.0;
+};
+
+inline juce::uint64 readCycleCounter() {
+#if BRAINWAVE_HAS_TSC
+    return static_cast<juce::uint64>(__rdtsc());
+#else
+    return 0;
+#endif
+}
+
+juce::AudioProcessorParameterWithID* findParameter(juce::AudioProcessor& processor, const juce::String& id) {
+    for (auto* param : processor.getParameters())
+        if (auto* withID = dynamic_cast<juce::AudioProcessorParameterWithID*>(param))
+            if (withID->paramID == id)
+                return withID;
+
+    return nullptr;
+}
+
+void setParameter(juce::AudioProcessorParameterWithID& param, float plainValue) {
+    if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(&param))
+        ranged->setValueNotifyingHost(ranged->convertTo0to1(plainValue));
+    else
+        param.setValueNotifyingHost(plainValue);
+}
+
+// Deterministic programme-like input: two detuned partials plus a little noise,
+// so level-dependent paths (gate trigger, auto gain, sidechain) stay active.
+void fillInput(juce::AudioBuffer<float>& buffer, juce::int64 startSample, double sampleRate, juce::Random& random) {
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
+        auto* data = buffer.getWritePointer(channel);
+        auto detune = channel == 0 ? 220.0 : 221.5;
+
+        for (int sample = 0; sample < buffer.getNumSamples(); ++sample) {
+            auto t = static_cast<double>(startSample + sample) / sampleRate;
+            data[sample] = static_cast<float>(0.2 * std::sin(juce::MathConstants<double>::twoPi * detune * t)
+                + 0.1 * std::sin(juce::MathConstants<double>::twoPi * 3.0 * detune * t))
+                + 0.02f * (random.nextFloat() * 2.0f - 1.0f);
+        }
+    }
+}
+
+RunResult runOnce(juce::AudioProcessor& processor, const BenchmarkSettings& settings, int blockSize) {
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::MidiBuffer midi;
+    juce::Random random(0x5eed);
+
+    processor.setPlayConfigDetails(2, 2, settings.sampleRate, blockSize);
+    processor.prepareToPlay(settings.sampleRate, blockSize);
+
+    auto totalSamples = static_cast<juce::int64>(settings.secondsPerRun * settings.sampleRate);
+    auto numBlocks = juce::jmax<juce::int64>(1, totalSamples / blockSize);
+
+    // Warm up caches, smoothers and branch predictors before timing.
+    for (juce::int64 block = 0; block < juce::jmin<juce::int64>(numBlocks, 32); ++block) {
+        fillInput(buffer, block * blockSize, settings.sampleRate, random);
+        processor.processBlock(buffer, midi);
+    }
+
+    double wallSeconds = 0.0;
+    juce::uint64 cycles = 0;
+
+    for (juce::int64 block = 0; block < numBlocks; ++block) {
+        // Input generation is kept outside the timed region.
+        fillInput(buffer, block * blockSize, settings.sampleRate, random);
+
+        auto startTime = std::chrono::steady_clock::now();
+        auto startCycles = readCycleCounter();
+        processor.processBlock(buffer, midi);
+        auto endCycles = readCycleCounter();
+        auto endTime = std::chrono::steady_clock::now();
+
+        wallSeconds += std::chrono::duration<double>(endTime - startTime).count();
+        cycles += endCycles - startCycles;
+    }
+
+    processor.releaseResources();
+
+    auto processedSamples = static_cast<double>(numBlocks * blockSize);
+
+    RunResult result;
+    result.nsPerSample = wallSeconds * 1.0e9 / processedSamples;
+    result.realtimeFactor = wallSeconds > 0.0 ? (processedSamples / settings.sampleRate) / wallSeconds : 0.0;
+#if BRAINWAVE_HAS_TSC
+    result.cyclesPerSample = static_cast<double>(cycles) / processedSamples;
+#endif
+    return result;
+}
+
+// Read by the processors in prepareToPlay (SimdDispatch.h)
+void setSimdTier(const juce::String& tier) {
+#if defined(_MSC_VER)
+    _putenv_s("BRAINWAVE_SIMD_TIER", tier.toRawUTF8());
+#else
+    setenv("BRAINWAVE_SIMD_TIER", tier.toRawUTF8(), 1);
+#endif
+}
+
+juce::String jsonEscape(const juce::String& text) {
+    return text.replace("\\", "\\\\").replace("\"", "\\\"");
+}
+
+bool parseArguments(int argc, char* argv[], BenchmarkSettings& settings) {
+    for (int i = 1; i < argc; ++i) {
+        juce::String arg(argv[i]);
+        auto hasValue = i + 1 < argc;
+
+        if (arg == "--sample-rate" && hasValue)     settings.sampleRate = juce::String(argv[++i]).getDoubleValue();
+        else if (arg == "--seconds" && hasValue)    settings.secondsPerRun = juce::String(argv[++i]).getDoubleValue();
+        else if (arg == "--min-block" && hasValue)  settings.minBlockSize = juce::String(argv[++i]).getIntValue();
+        else if (arg == "--max-block" && hasValue)  settings.maxBlockSize = juce::String(argv[++i]).getIntValue();
+        else if (arg == "--set" && hasValue)        settings.overrides.add(argv[++i]);
+        else if (arg == "--output" && hasValue)     settings.outputFile = argv[++i];
+        else if (arg == "--simd-tier" && hasValue)  settings.simdTier = argv[++i];
+        else {
+            std::fprintf(stderr, "Unknown or incomplete argument: %s\n", argv[i]);
+            return false;
+        }
+    }
+
+    return settings.sampleRate > 0.0 && settings.secondsPerRun > 0.0
+        && settings.minBlockSize > 0 && settings.maxBlockSize >= settings.minBlockSize;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    BenchmarkSettings settings;
+    if (!parseArguments(argc, argv, settings))
+        return 1;
+
+    if (settings.simdTier.isNotEmpty())
+        setSimdTier(settings.simdTier);
+
+    std::unique_ptr<juce::AudioProcessor> processor(createPluginFilter());
+
+    // Fixed parameter overrides, e.g. --set noise_amount=0.5
+    for (auto& assignment : settings.overrides) {
+        auto id = assignment.upToFirstOccurrenceOf("=", false, false);
+        auto* param = findParameter(*processor, id);
+        if (param == nullptr) {
+            std::fprintf(stderr, "Unknown parameter: %s\n", id.toRawUTF8());
+            return 1;
+        }
+        setParameter(*param, assignment.fromFirstOccurrenceOf("=", false, false).getFloatValue());
+    }
+
+    std::vector<SweepAxis> axes;
+    for (auto* id : sweptParameterIDs)
+        if (auto* choice = dynamic_cast<juce::AudioParameterChoice*>(findParameter(*processor, id)))
+            axes.push_back({ id, choice });
+
+    juce::String json;
+    json << "{\n  \"plugin\": \"" << jsonEscape(processor->getName()) << "\",\n"
+         << "  \"sampleRate\": " << settings.sampleRate << ",\n"
+         << "  \"secondsPerRun\": " << settings.secondsPerRun << ",\n"
+         << "  \"simdTier\": \"" << jsonEscape(settings.simdTier.isNotEmpty() ? settings.simdTier : "auto") << "\",\n"
+         << "  \"results\": [";
+
+    std::vector<int> indices(axes.size(), 0);
+    bool firstResult = true;
+
+    for (;;) {
+        for (size_t axis = 0; axis < axes.size(); ++axis)
+            setParameter(*axes[axis].parameter, static_cast<float>(indices[axis]));
+
+        for (int blockSize = settings.minBlockSize; blockSize <= settings.maxBlockSize; blockSize *= 2) {
+            auto result = runOnce(*processor, settings, blockSize);
+
+            json << (firstResult ? "\n" : ",\n") << "    { ";
+            firstResult = false;
+
+            for (size_t axis = 0; axis < axes.size(); ++axis)
+                json << "\"" << axes[axis].id << "\": \""
+                     << jsonEscape(axes[axis].parameter->choices[indices[axis]]) << "\", ";
+
+            json << "\"blockSize\": " << blockSize
+                 << ", \"nsPerSample\": " << juce::String(result.nsPerSample, 3)
+                 << ", \"realtimeFactor\": " << juce::String(result.realtimeFactor, 1)
+                 << ", \"cyclesPerSample\": " << juce::String(result.cyclesPerSample, 2) << " }";
+        }
+
+        // Advance the mixed-radix counter over all swept axes.
+        size_t axis = 0;
+        for (; axis < axes.size(); ++axis) {
+            if (++indices[axis] < axes[axis].parameter->choices.size())
+                break;
+            indices[axis] = 0;
+        }
+
+        if (axis == axes.size())
+            break;
+    }
+
+    json << "\n  ]\n}\n";
+
+    if (settings.outputFile.isNotEmpty())
+        return juce::File::getCurrentWorkingDirectory().getChildFile(settings.outputFile)
+            .replaceWithText(json) ? 0 : 1;
+
+    std::fputs(json.toRawUTF8(), stdout);
+    return 0;
+}
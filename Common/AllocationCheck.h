@@ -0,0 +1,46 @@
+#pragma once
+#include <JuceHeader.h>
+
+// ============================================================================
+// AUDIO THREAD ALLOCATION CHECK
+// ============================================================================
+//
+// Define BRAINWAVE_CHECK_ALLOCATIONS=1 in a debug build to assert on any heap
+// allocation made by a thread inside a ScopedNoAllocations, which
+// processBlock opens for its whole duration. Allocations are seen by
+// replacing the global operator new in PluginProcessor.cpp; a plugin binary
+// can end up serving the host's allocations with it, so this stays off in
+// shipping builds and is meant for test hosts and the benchmark.
+
+#ifndef BRAINWAVE_CHECK_ALLOCATIONS
+#define BRAINWAVE_CHECK_ALLOCATIONS 0
+#endif
+
+#if BRAINWAVE_CHECK_ALLOCATIONS
+namespace AllocationCheck {
+    inline thread_local int noAllocationDepth = 0;
+    inline thread_local bool reporting = false;
+
+    // Called from the replacement operator new
+    inline void noteAllocation() {
+        if (noAllocationDepth > 0 && !reporting) {
+            reporting = true;       // the assertion handler may allocate
+            jassertfalse;           // heap allocation on the audio thread
+            reporting = false;
+        }
+    }
+}
+#endif
+
+// Marks a scope in which the current thread must not allocate
+struct ScopedNoAllocations {
+#if BRAINWAVE_CHECK_ALLOCATIONS
+    ScopedNoAllocations() { ++AllocationCheck::noAllocationDepth; }
+    ~ScopedNoAllocations() { --AllocationCheck::noAllocationDepth; }
+#else
+    ScopedNoAllocations() {}
+#endif
+
+    ScopedNoAllocations(const ScopedNoAllocations&) = delete;
+    ScopedNoAllocations& operator=(const ScopedNoAllocations&) = delete;
+};
@@ -0,0 +1,108 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <cmath>
+
+// ============================================================================
+// SIMD LANE BIQUADS
+// ============================================================================
+//
+// Independent biquads side by side in one juce::dsp::SIMDRegister: lane 0
+// left and lane 1 right, or all four bands of a stereo crossover. Each lane
+// has its own coefficients and state, and runs the same direct form I
+// arithmetic as a scalar biquad, so its output matches one bit for bit.
+//
+// The feedback of a biquad cannot be vectorised along time the way the gain
+// loops around it are, so this is where its SIMD comes from: one register
+// recursion instead of one scalar recursion per channel. processBlock
+// interleaves the channels into frames first so the recursion only does
+// aligned loads and stores. The register is the baseline build's width in
+// every SimdDispatch tier; at most four filters share it anyway.
+
+class BiquadLanes {
+public:
+    using Register = juce::dsp::SIMDRegister<float>;
+
+    static constexpr int numLanes = static_cast<int>(Register::SIMDNumElements);
+    static_assert(numLanes >= 4, "a stereo crossover needs four lanes");
+
+    void setLowpass(int lane, double sampleRate, float cutoffHz, float Q = 0.707f) {
+        float w0 = juce::MathConstants<float>::twoPi * cutoffHz / static_cast<float>(sampleRate);
+        float cosw0 = std::cos(w0);
+        float alpha = std::sin(w0) / (2.0f * Q);
+
+        setCoefficients(lane, (1.0f - cosw0) / 2.0f, 1.0f - cosw0, (1.0f - cosw0) / 2.0f,
+            1.0f + alpha, -2.0f * cosw0, 1.0f - alpha);
+    }
+
+    void setHighpass(int lane, double sampleRate, float cutoffHz, float Q = 0.707f) {
+        float w0 = juce::MathConstants<float>::twoPi * cutoffHz / static_cast<float>(sampleRate);
+        float cosw0 = std::cos(w0);
+        float alpha = std::sin(w0) / (2.0f * Q);
+
+        setCoefficients(lane, (1.0f + cosw0) / 2.0f, -(1.0f + cosw0), (1.0f + cosw0) / 2.0f,
+            1.0f + alpha, -2.0f * cosw0, 1.0f - alpha);
+    }
+
+    void reset() {
+        x1 = x2 = y1 = y2 = Register::expand(0.0f);
+    }
+
+    // One sample per lane
+    Register process(Register input) noexcept {
+        auto output = b0 * input + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+
+        x2 = x1;
+        x1 = input;
+        y2 = y1;
+        y1 = output;
+
+        return output;
+    }
+
+    // Filters inputs[c] into outputs[c] on lane c, for numChannels <= numLanes.
+    // An input may be read by several lanes and may be its own output. Lanes
+    // past numChannels run on stale data and are discarded.
+    void processBlock(const float* const* inputs, float* const* outputs, int numChannels, int numSamples) {
+        jassert(numChannels <= numLanes);
+
+        for (int start = 0; start < numSamples; start += framesPerChunk) {
+            auto count = juce::jmin(framesPerChunk, numSamples - start);
+
+            for (int c = 0; c < numChannels; ++c)
+                for (int i = 0; i < count; ++i)
+                    frames[static_cast<size_t>(i * numLanes + c)] = inputs[c][start + i];
+
+            for (int i = 0; i < count; ++i) {
+                auto* frame = frames.data() + i * numLanes;
+                process(Register::fromRawArray(frame)).copyToRawArray(frame);
+            }
+
+            for (int c = 0; c < numChannels; ++c)
+                for (int i = 0; i < count; ++i)
+                    outputs[c][start + i] = frames[static_cast<size_t>(i * numLanes + c)];
+        }
+    }
+
+private:
+    static constexpr int framesPerChunk = 64;
+
+    Register b0 = Register::expand(1.0f), b1 = Register::expand(0.0f), b2 = Register::expand(0.0f);
+    Register a1 = Register::expand(0.0f), a2 = Register::expand(0.0f);
+    Register x1 = Register::expand(0.0f), x2 = Register::expand(0.0f);
+    Register y1 = Register::expand(0.0f), y2 = Register::expand(0.0f);
+
+    // Lane-interleaved staging for processBlock
+    alignas(Register::SIMDRegisterSize) std::array<float, static_cast<size_t>(framesPerChunk * numLanes)> frames{};
+
+    void setCoefficients(int lane, float b0Raw, float b1Raw, float b2Raw, float a0Raw, float a1Raw, float a2Raw) {
+        jassert(juce::isPositiveAndBelow(lane, numLanes));
+        auto index = static_cast<size_t>(lane);
+
+        b0.set(index, b0Raw / a0Raw);
+        b1.set(index, b1Raw / a0Raw);
+        b2.set(index, b2Raw / a0Raw);
+        a1.set(index, a1Raw / a0Raw);
+        a2.set(index, a2Raw / a0Raw);
+    }
+};
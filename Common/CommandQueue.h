@@ -0,0 +1,100 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// ============================================================================
+// LOCK-FREE COMMAND QUEUE
+// ============================================================================
+//
+// Carries small typed commands from parameter listeners, which run on
+// whichever thread the host uses (often the audio thread itself), to the
+// audio thread. It is a bounded multi-producer, single-consumer ring with a
+// sequence number per slot:
+//
+//   - A writer claims the next slot with one compare-and-swap on the write
+//     position, copies its command in and publishes it by bumping the
+//     slot's sequence. No writer ever waits for another.
+//   - The reader takes slots in order while their sequence says they are
+//     published. A slot claimed by a writer that was preempted mid-copy
+//     just ends this drain; the command is picked up by the next one.
+//
+// So neither side can be held up by a preempted thread. A full queue drops
+// the command and raises an overflow flag; the reader then knows to re-read
+// every parameter instead of trusting the queue.
+
+template <typename Command, int Capacity>
+class CommandQueue {
+public:
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    CommandQueue() {
+        for (size_t i = 0; i < slots.size(); ++i)
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // Any thread. Returns false if the queue was full.
+    bool push(const Command& command) {
+        auto position = writePosition.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+
+        for (;;) {
+            slot = &slots[position & mask];
+            auto sequence = slot->sequence.load(std::memory_order_acquire);
+            auto lag = static_cast<std::ptrdiff_t>(sequence - position);
+
+            if (lag == 0) {
+                // Free for this lap; claim it unless another writer got there first
+                if (writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (lag < 0) {
+                // Still holds a command from the previous lap
+                overflowed.store(true, std::memory_order_release);
+                return false;
+            }
+            else {
+                position = writePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->command = command;
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Reader only. Calls apply for every published command, oldest first.
+    // Takes at most one ring's worth, so writers cannot keep it looping.
+    template <typename Apply>
+    void drain(Apply&& apply) {
+        for (int i = 0; i < Capacity; ++i) {
+            auto& slot = slots[readPosition & mask];
+
+            if (slot.sequence.load(std::memory_order_acquire) != readPosition + 1)
+                break;
+
+            apply(slot.command);
+            slot.sequence.store(readPosition + static_cast<size_t>(Capacity), std::memory_order_release);
+            ++readPosition;
+        }
+    }
+
+    // Reader only. True once after any command has been dropped.
+    bool checkAndClearOverflow() {
+        return overflowed.exchange(false, std::memory_order_acq_rel);
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence{ 0 };
+        Command command{};
+    };
+
+    static constexpr size_t mask = static_cast<size_t>(Capacity) - 1;
+
+    std::array<Slot, static_cast<size_t>(Capacity)> slots;
+    std::atomic<size_t> writePosition{ 0 };
+    size_t readPosition = 0;                    // reader only
+    std::atomic<bool> overflowed{ false };
+};
@@ -0,0 +1,183 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+// ============================================================================
+// FAST TRANSCENDENTAL KERNELS
+// ============================================================================
+//
+// Branch-free polynomial sin / exp / tanh for the per-sample loops. They use
+// only arithmetic, min / max and integer bit manipulation, so loops built on them
+// auto-vectorise where the library calls would not.
+//
+// Each function takes a Precision tier chosen at compile time by the caller
+// (see MathTier in PluginProcessor.h). Maximum errors, measured over the full
+// reduced range in double precision (float results are additionally limited
+// by float rounding, ~6e-8):
+//
+//                 sin2pi (absolute)   exp (relative)
+//     Draft       6.8e-5              7.5e-5
+//     Standard    5.9e-7              7.5e-8
+//     High        3.4e-9              1.9e-9
+//
+// Coefficients are minimax fits (Lawson iteration) of sin(2 pi r) over
+// |r| <= 1/4 and of 2^f over [0, 1).
+
+namespace FastMath {
+
+enum class Precision {
+    Draft = 0,
+    Standard,
+    High
+};
+
+namespace detail {
+
+template <typename T> struct FloatTraits;
+
+template <> struct FloatTraits<float> {
+    using Int = std::int32_t;
+    static constexpr int mantissaBits = 23;
+    static constexpr int exponentBias = 127;
+    static constexpr int maxExponent = 126;
+    static constexpr float roundingMagic = 12582912.0f;     // 1.5 * 2^23
+    static constexpr float ln2High = 0.693145751953125f;    // ln 2 split for exact n * ln 2
+    static constexpr float ln2Low = 1.428606765330187e-6f;
+};
+
+template <> struct FloatTraits<double> {
+    using Int = std::int64_t;
+    static constexpr int mantissaBits = 52;
+    static constexpr int exponentBias = 1023;
+    static constexpr int maxExponent = 1022;
+    static constexpr double roundingMagic = 6755399441055744.0;  // 1.5 * 2^52
+    static constexpr double ln2High = 0.6931471803691238;
+    static constexpr double ln2Low = 1.9082149292705877e-10;
+};
+
+// Rounds towards zero
+template <typename T>
+inline T truncate(T x) {
+    return static_cast<T>(static_cast<typename FloatTraits<T>::Int>(x));
+}
+
+// floor(x) for |x| < 2^21, as an integer and as T. Adding 1.5 * 2^mantissaBits
+// leaves the rounded integer in the low mantissa bits.
+template <typename T>
+inline typename FloatTraits<T>::Int floorToInt(T x, T& floored) {
+    using Traits = FloatTraits<T>;
+    using Int = typename Traits::Int;
+
+    T shifted = (x - T(0.5)) + T(Traits::roundingMagic);
+    T magic = T(Traits::roundingMagic);
+    Int shiftedBits, magicBits;
+    std::memcpy(&shiftedBits, &shifted, sizeof(shifted));
+    std::memcpy(&magicBits, &magic, sizeof(magic));
+
+    auto n = shiftedBits - magicBits;
+    floored = static_cast<T>(n);
+    return n;
+}
+
+// 2^n, with n saturated to the normal exponent range. The clamp is done on
+// integers: a float clamp in front of the arithmetic is turned back into a
+// branch by GCC, which then refuses to vectorise the loop.
+template <typename T>
+inline T exponentScale(typename FloatTraits<T>::Int n) {
+    using Traits = FloatTraits<T>;
+    using Int = typename Traits::Int;
+    n = n > Int(Traits::maxExponent) ? Int(Traits::maxExponent) : n;
+    n = n < Int(-Traits::maxExponent) ? Int(-Traits::maxExponent) : n;
+    auto bits = (n + Traits::exponentBias) << Traits::mantissaBits;
+    T result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+// sin(2 pi r) for |r| <= 1/4, as r * P(r^2)
+template <Precision P, typename T>
+inline T sinPolynomial(T r) {
+    auto r2 = r * r;
+
+    if constexpr (P == Precision::Draft)
+        return r * (T(6.281280034594527) + r2 * (T(-41.0952389844927) + r2 * T(73.58545460786742)));
+    else if constexpr (P == Precision::Standard)
+        return r * (T(6.283164043845127) + r2 * (T(-41.33714229482363) + r2 * (T(81.34076590082223)
+            + r2 * T(-70.99340104119098))));
+    else
+        return r * (T(6.283185160095918) + r2 * (T(-41.341655032538085) + r2 * (T(81.60100412579663)
+            + r2 * (T(-76.54978318072627) + r2 * T(39.536710809142406)))));
+}
+
+// 2^f for 0 <= f <= 1
+template <Precision P, typename T>
+inline T exp2Polynomial(T f) {
+    if constexpr (P == Precision::Draft)
+        return T(0.9999252285575981) + f * (T(0.6958334816464509) + f * (T(0.22606721205590755)
+            + f * T(0.07802453156862417)));
+    else if constexpr (P == Precision::Standard)
+        return T(0.9999999250796694) + f * (T(0.6931530728945662) + f * (T(0.24015361852879774)
+            + f * (T(0.05582631538726935) + f * (T(0.00898934187920755) + f * T(0.001877576384352267)))));
+    else
+        return T(1.0000000018550355) + f * (T(0.6931469838706024) + f * (T(0.2402298360093653)
+            + f * (T(0.05548334290361587) + f * (T(0.009678839511563732) + f * (T(0.001243969900447376)
+            + f * T(0.00021702223853296837))))));
+}
+
+} // namespace detail
+
+// sin(2 pi x), x in cycles. |x| must fit the integer type (2^31 for float).
+template <Precision P, typename T>
+inline T sin2pi(T x) {
+    auto r = x - detail::truncate(x);       // (-1, 1)
+    r -= detail::truncate(r + r);           // [-1/2, 1/2]
+
+    // sin(2 pi (1/2 - r)) = sin(2 pi r) folds onto [-1/4, 1/4]
+    r = std::min(r, T(0.5) - r);
+    r = std::max(r, T(-0.5) - r);
+
+    return detail::sinPolynomial<P>(r);
+}
+
+template <Precision P, typename T>
+inline T cos2pi(T x) {
+    return sin2pi<P>(x + T(0.25));
+}
+
+// sin(2 pi phase / 2^32) for a 32-bit fixed-point phase (PhaseAccumulator.h).
+// Read as signed, the phase is already reduced to [-1/2, 1/2) cycles.
+template <Precision P>
+inline float sinPhase(std::uint32_t phase) {
+    auto r = static_cast<float>(static_cast<std::int32_t>(phase)) * (1.0f / 4294967296.0f);
+    r = std::min(r, 0.5f - r);
+    r = std::max(r, -0.5f - r);
+    return detail::sinPolynomial<P>(r);
+}
+
+template <Precision P>
+inline float cosPhase(std::uint32_t phase) {
+    return sinPhase<P>(phase + 0x40000000u);
+}
+
+// e^x for |x| < 2^20. Results saturate instead of overflowing to infinity
+// or going denormal (below about -87 or above 88 for float).
+template <Precision P, typename T>
+inline T exp(T x) {
+    using Traits = detail::FloatTraits<T>;
+
+    // x = n ln 2 + r with n = floor(x / ln 2); ln 2 is split so n ln 2 is exact
+    T n;
+    auto exponent = detail::floorToInt(x * T(1.4426950408889634), n);
+    auto r = (x - n * T(Traits::ln2High)) - n * T(Traits::ln2Low);
+
+    return detail::exp2Polynomial<P>(r * T(1.4426950408889634)) * detail::exponentScale<T>(exponent);
+}
+
+template <Precision P, typename T>
+inline T tanh(T x) {
+    auto e = exp<P>(x + x);
+    return (e - T(1)) / (e + T(1));
+}
+
+} // namespace FastMath
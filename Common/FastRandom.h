@@ -0,0 +1,102 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+// ============================================================================
+// FAST BLOCK RANDOM GENERATOR
+// ============================================================================
+//
+// xoshiro128+ run as numLanes independent streams in structure-of-arrays
+// layout, so one step of all lanes is plain 32-bit adds, shifts and xors
+// across a contiguous array and vectorises to 4 (SSE2) or 8 (AVX2) lanes.
+// State plus an output cache is 164 bytes, against ~5 KB for std::mt19937.
+//
+// Floats are made without division: the top 23 bits of each output become
+// the mantissa of a float in [2, 4), and subtracting 3 maps that onto
+// [-1, 1). xoshiro128+'s weak low bits are discarded by the shift.
+
+class FastRandom {
+public:
+    static constexpr int numLanes = 8;
+
+    explicit FastRandom(std::uint64_t seed = 0x853c49e6748fea9bULL) {
+        setSeed(seed);
+    }
+
+    void setSeed(std::uint64_t seed) {
+        // splitmix64 spreads one seed over every lane's state
+        for (int word = 0; word < 4; ++word) {
+            for (int lane = 0; lane < numLanes; ++lane) {
+                seed += 0x9e3779b97f4a7c15ULL;
+                auto z = seed;
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                z ^= z >> 31;
+                state[word][lane] = static_cast<std::uint32_t>(z >> 32) | 1u;  // never all-zero
+            }
+        }
+        cachePosition = numLanes;
+    }
+
+    // Uniform in [-1, 1)
+    float nextFloat() {
+        if (cachePosition >= numLanes) {
+            advance(state, cache);
+            cachePosition = 0;
+        }
+        return cache[cachePosition++];
+    }
+
+    // Uniform integer in [0, range)
+    int nextInt(int range) {
+        auto index = static_cast<int>((nextFloat() + 1.0f) * 0.5f * static_cast<float>(range));
+        return index < range ? index : range - 1;
+    }
+
+    // Uniform in [-1, 1)
+    void generateBlock(float* output, int numSamples) {
+        int i = 0;
+
+        if (numSamples >= numLanes) {
+            // Work on a local copy so the state stays in registers
+            std::uint32_t s[4][numLanes];
+            std::memcpy(s, state, sizeof(s));
+
+            for (; i + numLanes <= numSamples; i += numLanes)
+                advance(s, output + i);
+
+            std::memcpy(state, s, sizeof(s));
+        }
+
+        for (; i < numSamples; ++i)
+            output[i] = nextFloat();
+    }
+
+private:
+    std::uint32_t state[4][numLanes];
+    float cache[numLanes];
+    int cachePosition = numLanes;
+
+    static std::uint32_t rotateLeft(std::uint32_t x, int k) {
+        return (x << k) | (x >> (32 - k));
+    }
+
+    static void advance(std::uint32_t (&s)[4][numLanes], float* output) {
+        for (int lane = 0; lane < numLanes; ++lane) {
+            auto result = s[0][lane] + s[3][lane];
+
+            auto t = s[1][lane] << 9;
+            s[2][lane] ^= s[0][lane];
+            s[3][lane] ^= s[1][lane];
+            s[1][lane] ^= s[2][lane];
+            s[0][lane] ^= s[3][lane];
+            s[2][lane] ^= t;
+            s[3][lane] = rotateLeft(s[3][lane], 11);
+
+            auto floatBits = (result >> 9) | 0x40000000u;  // [2, 4)
+            float value;
+            std::memcpy(&value, &floatBits, sizeof(value));
+            output[lane] = value - 3.0f;
+        }
+    }
+};
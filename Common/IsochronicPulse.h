@@ -0,0 +1,247 @@
+#pragma once
+#include <JuceHeader.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include "PhaseAccumulator.h"
+
+// ============================================================================
+// SHAPED ISOCHRONIC PULSES
+// ============================================================================
+//
+// A pulse is on for the first `duty` of each beat cycle, with a rise of
+// `edge` cycles at the start and a fall of `edge` cycles at the end:
+//
+//     gain = rise(phase / edge) * fall((phase - duty + edge) / edge)
+//
+// with both arguments clamped to [0, 1], rise(0) = 0, rise(1) = 1,
+// fall(0) = 1 and fall(1) = 0. Only samples on an edge read a table, so the
+// cost is the same for every shape and mostly spent on fills. The edge is set
+// in seconds so its sharpness, and so the click it could cause, doesn't
+// depend on the beat rate; it is limited to half the on-time.
+//
+// Edge curves, each sampled once into a shared read-only table:
+//
+//     RaisedCosine       0.5 (1 - cos(pi x))
+//     Trapezoid          x
+//     Exponential        RC charge / discharge, 5 time constants per edge
+//     BandLimitedSquare  integrated Blackman window: above 3 / edge Hz the
+//                        edge is at least 58 dB below an ideal step
+
+enum class PulseShape {
+    Sine = 0,           // legacy raised sine, rendered by the gate LFO
+    RaisedCosine,
+    Trapezoid,
+    Exponential,
+    BandLimitedSquare
+};
+
+class PulseEdgeTables {
+public:
+    static constexpr int tableSize = 512;
+    static constexpr int numShapes = 4;       // every PulseShape after Sine
+
+    static std::shared_ptr<const PulseEdgeTables> getShared() {
+        static std::mutex creationLock;
+        static std::weak_ptr<const PulseEdgeTables> sharedTables;
+
+        const std::lock_guard<std::mutex> lock(creationLock);
+        auto tables = sharedTables.lock();
+        if (tables == nullptr) {
+            tables = std::make_shared<const PulseEdgeTables>();
+            sharedTables = tables;
+        }
+        return tables;
+    }
+
+    PulseEdgeTables() {
+        constexpr double pi = juce::MathConstants<double>::pi;
+        constexpr double exponentialRate = 5.0;
+        const double exponentialEnd = std::exp(-exponentialRate);
+
+        for (int i = 0; i <= tableSize; ++i) {
+            auto x = static_cast<double>(i) / tableSize;
+
+            auto raisedCosine = 0.5 * (1.0 - std::cos(pi * x));
+            auto blackmanStep = (0.42 * x - 0.5 * std::sin(2.0 * pi * x) / (2.0 * pi)
+                + 0.08 * std::sin(4.0 * pi * x) / (4.0 * pi)) / 0.42;
+            auto charge = (1.0 - std::exp(-exponentialRate * x)) / (1.0 - exponentialEnd);
+            auto discharge = (std::exp(-exponentialRate * x) - exponentialEnd) / (1.0 - exponentialEnd);
+
+            setPoint(PulseShape::RaisedCosine, i, raisedCosine, 1.0 - raisedCosine);
+            setPoint(PulseShape::Trapezoid, i, x, 1.0 - x);
+            setPoint(PulseShape::Exponential, i, charge, discharge);
+            setPoint(PulseShape::BandLimitedSquare, i, blackmanStep, 1.0 - blackmanStep);
+        }
+    }
+
+    // tableSize + 1 points over [0, 1]
+    const float* getRise(PulseShape shape) const { return rise[index(shape)].data(); }
+    const float* getFall(PulseShape shape) const { return fall[index(shape)].data(); }
+
+    // x in [0, 1]
+    static float read(const float* table, float x) {
+        auto position = x * static_cast<float>(tableSize);
+        auto i = juce::jmin(static_cast<int>(position), tableSize - 1);
+        auto frac = position - static_cast<float>(i);
+        return table[i] + frac * (table[i + 1] - table[i]);
+    }
+
+private:
+    std::array<std::array<float, tableSize + 1>, numShapes> rise;
+    std::array<std::array<float, tableSize + 1>, numShapes> fall;
+
+    static size_t index(PulseShape shape) {
+        return static_cast<size_t>(juce::jlimit(1, numShapes, static_cast<int>(shape)) - 1);
+    }
+
+    void setPoint(PulseShape shape, int i, double riseValue, double fallValue) {
+        rise[index(shape)][static_cast<size_t>(i)] = static_cast<float>(riseValue);
+        fall[index(shape)][static_cast<size_t>(i)] = static_cast<float>(fallValue);
+    }
+};
+
+class IsochronicPulse {
+public:
+    IsochronicPulse()
+        : tables(PulseEdgeTables::getShared()) {
+        updateTables();
+    }
+
+    void setSampleRate(double sr) {
+        invSampleRate = static_cast<float>(1.0 / sr);
+        edgeFrequency = -1.0f;
+    }
+
+    // Sine is rendered by the caller's gate LFO; here it falls back to RaisedCosine
+    void setShape(PulseShape newShape) {
+        shape = newShape;
+        updateTables();
+    }
+
+    // Fraction of each cycle the pulse is on, 0.05..0.95
+    void setDuty(float newDuty) {
+        duty = juce::jlimit(0.05f, 0.95f, newDuty);
+        edgeFrequency = -1.0f;
+    }
+
+    void setEdgeTime(float seconds) {
+        edgeSeconds = juce::jmax(0.0f, seconds);
+        edgeFrequency = -1.0f;
+    }
+
+    void reset(float newPhase = 0.0f) {
+        phase = Phase::fromCycles(newPhase);
+    }
+
+    // Gain 0..1, then advances one sample
+    float process(float frequencyHz) {
+        auto gain = gainAt(frequencyHz);
+        advance(frequencyHz);
+        return gain;
+    }
+
+    // Renders numSamples gains from one beat frequency per sample. The rate
+    // is latched every chunkSize samples, so a chunk that lies entirely on
+    // the plateau or in the gap is a plain fill.
+    void processBlock(float* output, const float* frequencyHz, int numSamples) {
+        render(output, numSamples, [frequencyHz](int i) { return frequencyHz[i]; });
+    }
+
+    void processBlock(float* output, float frequencyHz, int numSamples) {
+        render(output, numSamples, [frequencyHz](int) { return frequencyHz; });
+    }
+
+private:
+    std::shared_ptr<const PulseEdgeTables> tables;
+    const float* riseTable = nullptr;
+    const float* fallTable = nullptr;
+
+    PulseShape shape = PulseShape::RaisedCosine;
+    float invSampleRate = 1.0f / 44100.0f;
+    float duty = 0.5f;
+    float edgeSeconds = 0.01f;
+    Phase::Type phase = 0;
+
+    // Derived from duty, edge time and the beat rate they were computed for
+    float edgeFrequency = -1.0f;
+    float edge = 0.0f;
+    float invEdge = 1.0f;
+    float fallStart = 0.0f;
+
+    static constexpr int chunkSize = 32;
+
+    // Shortest edge, in samples, so even the sharpest setting is a ramp
+    static constexpr float minEdgeSamples = 4.0f;
+
+    void updateTables() {
+        auto tableShape = shape == PulseShape::Sine ? PulseShape::RaisedCosine : shape;
+        riseTable = tables->getRise(tableShape);
+        fallTable = tables->getFall(tableShape);
+    }
+
+    template <typename FrequencyAt>
+    void render(float* output, int numSamples, FrequencyAt frequencyAt) {
+        for (int start = 0; start < numSamples; start += chunkSize) {
+            auto count = juce::jmin(chunkSize, numSamples - start);
+            auto frequency = frequencyAt(start);
+            auto increment = frequency * invSampleRate;
+            auto step = Phase::fromIncrement(increment);
+
+            if (frequency != edgeFrequency)
+                updateEdge(frequency);
+
+            // Most chunks sit wholly on the plateau or in the gap
+            auto first = Phase::toCycles(phase);
+            auto last = first + static_cast<float>(count - 1) * increment;
+            auto* out = output + start;
+
+            if (last < 1.0f && first >= edge && last < fallStart) {
+                std::fill(out, out + count, 1.0f);
+            }
+            else if (last < 1.0f && first >= duty) {
+                std::fill(out, out + count, 0.0f);
+            }
+            else {
+                for (int i = 0; i < count; ++i)
+                    out[i] = gainAtPhase(Phase::toCycles(phase + static_cast<Phase::Type>(i) * step));
+            }
+
+            phase += static_cast<Phase::Type>(count) * step;
+        }
+    }
+
+    float gainAt(float frequencyHz) {
+        if (frequencyHz != edgeFrequency)
+            updateEdge(frequencyHz);
+
+        return gainAtPhase(Phase::toCycles(phase));
+    }
+
+    // Outside the two edges the gain is a constant 0 or 1 and no table is read
+    float gainAtPhase(float p) const {
+        if (p < edge)
+            return PulseEdgeTables::read(riseTable, p * invEdge);
+        if (p < fallStart)
+            return 1.0f;
+        if (p < duty)
+            return PulseEdgeTables::read(fallTable, (p - fallStart) * invEdge);
+        return 0.0f;
+    }
+
+    // The edge in cycles only changes with the beat rate, which is normally
+    // constant for a whole block
+    void updateEdge(float frequencyHz) {
+        auto minEdge = minEdgeSamples * frequencyHz * invSampleRate;
+        edge = juce::jlimit(juce::jmin(minEdge, 0.5f * duty), 0.5f * duty, edgeSeconds * frequencyHz);
+        invEdge = 1.0f / edge;
+        fallStart = duty - edge;
+        edgeFrequency = frequencyHz;
+    }
+
+    void advance(float frequencyHz) {
+        phase += Phase::fromIncrement(frequencyHz * invSampleRate);
+    }
+};
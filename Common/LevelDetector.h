@@ -0,0 +1,237 @@
+#pragma once
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+// BLOCK LEVEL DETECTOR
+// ============================================================================
+//
+// Input level is measured per sub-block of subBlockSize samples: the peak
+// (largest |x| over every channel) or the mean square. Both are lane-wise
+// reductions over numLanes partial results, so they vectorise without
+// reassociation flags. One ballistic step per sub-block then moves the
+// envelope towards that level in closed form,
+//
+//     envelope = level + (envelope - level) * exp(-count / (tau * sampleRate))
+//
+// which is exactly what a per-sample one-pole would reach for a constant
+// input, at the cost of one multiply. The exponentials for a full sub-block
+// are cached, so advancing any number of samples is O(1) per sub-block.
+// Hold keeps the envelope from releasing until the level has stayed below it
+// for the hold time. The envelope is written out per sample as a linear ramp
+// between sub-block ends.
+//
+// RMS ballistics act on the mean square and the output is its square root.
+
+class LevelDetector {
+public:
+    enum class Mode {
+        Peak = 0,
+        Rms
+    };
+
+    static constexpr int subBlockSize = 32;
+    static constexpr int numLanes = 8;
+
+    void prepare(double sr) {
+        sampleRate = sr;
+        updateCoefficients();
+        reset();
+    }
+
+    void setMode(Mode newMode) {
+        mode = newMode;
+    }
+
+    void setAttackTime(float ms) {
+        attackMs = ms;
+        updateCoefficients();
+    }
+
+    void setReleaseTime(float ms) {
+        releaseMs = ms;
+        updateCoefficients();
+    }
+
+    void setHoldTime(float ms) {
+        holdSamples = static_cast<int>(static_cast<double>(ms) * 0.001 * sampleRate);
+    }
+
+    void reset() {
+        state = 0.0f;
+        holdRemaining = 0;
+    }
+
+    // Linear amplitude
+    float getEnvelope() const {
+        return toAmplitude(state);
+    }
+
+    // Detects numChannels channels and writes numSamples envelope values
+    void processBlock(const float* const* channels, int numChannels, int numSamples, float* envelope) {
+        for (int start = 0; start < numSamples; start += subBlockSize) {
+            auto count = juce::jmin(subBlockSize, numSamples - start);
+            auto previous = getEnvelope();
+
+            step(detect(channels, numChannels, start, count), count);
+
+            auto slope = (getEnvelope() - previous) / static_cast<float>(count);
+            for (int i = 0; i < count; ++i)
+                envelope[start + i] = previous + slope * static_cast<float>(i + 1);
+        }
+    }
+
+    // Advances numSamples samples at a constant amplitude in O(1)
+    void advance(float amplitude, int numSamples) {
+        auto level = mode == Mode::Rms ? amplitude * amplitude : amplitude;
+        step(level, numSamples);
+    }
+
+private:
+    Mode mode = Mode::Peak;
+    double sampleRate = 44100.0;
+    float attackMs = 10.0f;
+    float releaseMs = 100.0f;
+    int holdSamples = 0;
+
+    float attackCoeff = 0.0f;     // per full sub-block
+    float releaseCoeff = 0.0f;
+
+    float state = 0.0f;           // amplitude (Peak) or mean square (Rms)
+    int holdRemaining = 0;
+
+    float toAmplitude(float value) const {
+        return mode == Mode::Rms ? std::sqrt(value) : value;
+    }
+
+    static float coefficient(float ms, int samples, double sr) {
+        auto timeConstant = juce::jmax(1.0e-6, static_cast<double>(ms) * 0.001 * sr);
+        return static_cast<float>(std::exp(-samples / timeConstant));
+    }
+
+    void updateCoefficients() {
+        attackCoeff = coefficient(attackMs, subBlockSize, sampleRate);
+        releaseCoeff = coefficient(releaseMs, subBlockSize, sampleRate);
+    }
+
+    float detect(const float* const* channels, int numChannels, int start, int count) const {
+        float lanes[numLanes] = {};
+        auto fullEnd = count - count % numLanes;
+
+        for (int channel = 0; channel < numChannels; ++channel) {
+            auto* x = channels[channel] + start;
+
+            if (mode == Mode::Peak) {
+                for (int i = 0; i < fullEnd; i += numLanes)
+                    for (int lane = 0; lane < numLanes; ++lane)
+                        lanes[lane] = std::max(lanes[lane], std::abs(x[i + lane]));
+                for (int i = fullEnd; i < count; ++i)
+                    lanes[0] = std::max(lanes[0], std::abs(x[i]));
+            }
+            else {
+                for (int i = 0; i < fullEnd; i += numLanes)
+                    for (int lane = 0; lane < numLanes; ++lane)
+                        lanes[lane] += x[i + lane] * x[i + lane];
+                for (int i = fullEnd; i < count; ++i)
+                    lanes[0] += x[i] * x[i];
+            }
+        }
+
+        float result = 0.0f;
+        if (mode == Mode::Peak) {
+            for (auto lane : lanes)
+                result = std::max(result, lane);
+            return result;
+        }
+
+        for (auto lane : lanes)
+            result += lane;
+        return result / static_cast<float>(count * juce::jmax(1, numChannels));
+    }
+
+    void step(float level, int count) {
+        if (level > state) {
+            auto coeff = count == subBlockSize ? attackCoeff : coefficient(attackMs, count, sampleRate);
+            state = level + (state - level) * coeff;
+            holdRemaining = holdSamples;
+            return;
+        }
+
+        // Hold first, then release for whatever is left of the step
+        auto held = juce::jmin(holdRemaining, count);
+        holdRemaining -= held;
+        auto releasing = count - held;
+
+        if (releasing > 0) {
+            auto coeff = releasing == subBlockSize ? releaseCoeff : coefficient(releaseMs, releasing, sampleRate);
+            state = level + (state - level) * coeff;
+        }
+    }
+};
+
+// ============================================================================
+// DETECTOR GATE
+// ============================================================================
+//
+// Opens when the envelope rises above the threshold and closes only when it
+// falls below threshold - hysteresis, so a level hovering at the threshold
+// doesn't chatter. The decision is made per sample and the gain moves
+// linearly to 0 or 1 over the ramp time.
+
+class DetectorGate {
+public:
+    void prepare(double sr) {
+        sampleRate = sr;
+        updateRamp();
+    }
+
+    void setThreshold(float dB) {
+        openLevel = juce::Decibels::decibelsToGain(dB);
+        closeLevel = juce::Decibels::decibelsToGain(dB - hysteresisDb);
+        thresholdDb = dB;
+    }
+
+    void setHysteresis(float dB) {
+        hysteresisDb = juce::jmax(0.0f, dB);
+        setThreshold(thresholdDb);
+    }
+
+    void setRampTime(float ms) {
+        rampMs = ms;
+        updateRamp();
+    }
+
+    void reset() {
+        open = false;
+        gain = 0.0f;
+    }
+
+    bool isOpen() const { return open; }
+
+    // envelope in linear amplitude; writes one gain (0..1) per sample
+    void process(const float* envelope, float* gainOut, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            open = open ? envelope[i] >= closeLevel : envelope[i] > openLevel;
+            auto target = open ? 1.0f : 0.0f;
+            gain += juce::jlimit(-rampStep, rampStep, target - gain);
+            gainOut[i] = gain;
+        }
+    }
+
+private:
+    double sampleRate = 44100.0;
+    float thresholdDb = -40.0f;
+    float hysteresisDb = 6.0f;
+    float openLevel = 0.01f;
+    float closeLevel = 0.005f;
+    float rampMs = 10.0f;
+    float rampStep = 0.0f;
+
+    bool open = false;
+    float gain = 0.0f;
+
+    void updateRamp() {
+        rampStep = static_cast<float>(1.0 / juce::jmax(1.0, static_cast<double>(rampMs) * 0.001 * sampleRate));
+    }
+};
@@ -0,0 +1,117 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cmath>
+
+// ============================================================================
+// LOCK-FREE METERING RING
+// ============================================================================
+//
+// Carries per-block levels from the audio thread to the editor. The audio
+// thread pushes one frame per host block and never waits; while nobody
+// drains (editor closed) the ring fills and new frames are dropped, so a new
+// editor skips that stale backlog before its first tick. The editor drains
+// every frame since its last timer tick, so transients shorter than a tick
+// still reach its ballistics and history.
+//
+// Single producer, single consumer. The ring is cache-line aligned and each
+// index has a line of its own, so the editor polling it never shares a line
+// with the producer's index or with DSP state next to the ring.
+
+struct MeterFrame {
+    float peakLeft = 0.0f;
+    float peakRight = 0.0f;
+    float rmsLeft = 0.0f;
+    float rmsRight = 0.0f;
+    float entrainment = 0.0f;       // RMS of the entrainment signal before the wet mix
+    float envelope = 0.0f;          // input detector at the end of the block
+    int numSamples = 0;
+};
+
+// Combines the levels of the chunks a block is processed in into one frame:
+// peaks by maximum, RMS levels through their sums of squares, and the
+// envelope as of the last chunk.
+class MeterAccumulator {
+public:
+    void reset() {
+        frame = {};
+        energyLeft = energyRight = energyEntrainment = 0.0;
+    }
+
+    void add(const MeterFrame& chunk) {
+        auto weight = static_cast<double>(chunk.numSamples);
+
+        frame.peakLeft = juce::jmax(frame.peakLeft, chunk.peakLeft);
+        frame.peakRight = juce::jmax(frame.peakRight, chunk.peakRight);
+        energyLeft += static_cast<double>(chunk.rmsLeft) * chunk.rmsLeft * weight;
+        energyRight += static_cast<double>(chunk.rmsRight) * chunk.rmsRight * weight;
+        energyEntrainment += static_cast<double>(chunk.entrainment) * chunk.entrainment * weight;
+        frame.envelope = chunk.envelope;
+        frame.numSamples += chunk.numSamples;
+    }
+
+    MeterFrame getFrame() const {
+        auto result = frame;
+
+        if (frame.numSamples > 0) {
+            auto count = static_cast<double>(frame.numSamples);
+            result.rmsLeft = static_cast<float>(std::sqrt(energyLeft / count));
+            result.rmsRight = static_cast<float>(std::sqrt(energyRight / count));
+            result.entrainment = static_cast<float>(std::sqrt(energyEntrainment / count));
+        }
+        return result;
+    }
+
+private:
+    MeterFrame frame;
+    double energyLeft = 0.0;
+    double energyRight = 0.0;
+    double energyEntrainment = 0.0;
+};
+
+template <int Capacity>
+class alignas(64) MeterRing {
+public:
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    // Audio thread only. Returns false if the ring was full.
+    bool push(const MeterFrame& frame) {
+        auto write = writeIndex.load(std::memory_order_relaxed);
+
+        if (write - readIndex.load(std::memory_order_acquire) == static_cast<juce::uint32>(Capacity))
+            return false;
+
+        frames[write & mask] = frame;
+        writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Editor only. Calls apply for every frame pushed since the last drain,
+    // oldest first, and returns how many there were.
+    template <typename Apply>
+    int drain(Apply&& apply) {
+        auto read = readIndex.load(std::memory_order_relaxed);
+        auto write = writeIndex.load(std::memory_order_acquire);
+
+        for (auto index = read; index != write; ++index)
+            apply(frames[index & mask]);
+
+        readIndex.store(write, std::memory_order_release);
+        return static_cast<int>(write - read);
+    }
+
+    // Editor only. Discards every queued frame, e.g. the backlog left while
+    // no editor was open.
+    void skipAll() {
+        readIndex.store(writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+private:
+    static constexpr juce::uint32 mask = static_cast<juce::uint32>(Capacity - 1);
+
+    // Free-running; the unsigned difference is the number of queued frames
+    alignas(64) std::atomic<juce::uint32> writeIndex{ 0 };
+    alignas(64) std::atomic<juce::uint32> readIndex{ 0 };
+    alignas(64) std::array<MeterFrame, static_cast<size_t>(Capacity)> frames{};
+};
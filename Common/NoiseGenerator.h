@@ -0,0 +1,521 @@
+#pragma once
+#include <JuceHeader.h>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include "FastRandom.h"
+
+// ============================================================================
+// NOISE GENERATOR
+// ============================================================================
+
+// How NoiseGenerator shapes white noise into pink
+enum class PinkNoiseAlgorithm {
+    Kellet = 0,         // 7-pole filter, accurate -3 dB/oct
+    VossMcCartney = 1   // octave-row sum, cheaper
+};
+
+// Spectral colour of the noise layer
+enum class NoiseColour {
+    White = 0,  // flat
+    Pink,       // -3 dB/oct
+    Brown,      // -6 dB/oct, leaky integrator
+    Blue,       // +3 dB/oct, differentiated pink
+    Violet,     // +6 dB/oct, differentiated white
+    Grey        // inverse equal-loudness curve
+};
+
+class NoiseGenerator {
+    using GroupRegister = juce::dsp::SIMDRegister<float>;
+
+public:
+    static constexpr int numStreams = 4;    // one SIMD register of floats
+    static constexpr int chunkSize = 64;
+    static constexpr int vossRows = 12;     // slowest row redrawn every 2^11 samples
+    static constexpr int greyStages = 3;
+
+    NoiseGenerator()
+        : random(std::random_device{}()) {
+        designKelletGroups();
+        prepare(44100.0);
+    }
+
+    // Sample-rate dependent filters: the brown leak and the grey EQ
+    void prepare(double sampleRate) {
+        // Leak corner well below the audio band keeps brown noise bounded
+        brownLeak = static_cast<float>(std::exp(-juce::MathConstants<double>::twoPi * 8.0 / sampleRate));
+        brownGain = outputLevel * std::sqrt((1.0f - brownLeak * brownLeak) * 3.0f);
+
+        // Roughly the inverse of the 40 phon equal-loudness contour: lift the
+        // lows, dip the ear's 3-4 kHz sensitivity peak, lift the top again.
+        // Shelves and peaks are minimum phase, so the cascade is too.
+        designGreyStage(greyEq[0], sampleRate, GreyStage::LowShelf, 150.0, 15.0, 0.707);
+        designGreyStage(greyEq[1], sampleRate, GreyStage::Peak, 3500.0, -6.0, 1.2);
+        designGreyStage(greyEq[2], sampleRate, GreyStage::HighShelf, 12000.0, 6.0, 0.707);
+
+        // White noise has variance 1/3; scale by the cascade's power gain
+        greyGain = outputLevel / std::sqrt(greyPowerGain() / 3.0f);
+
+        reset();
+    }
+
+    void setPinkAlgorithm(PinkNoiseAlgorithm newAlgorithm) {
+        algorithm = newAlgorithm;
+    }
+
+    void setColour(NoiseColour newColour) {
+        colour = newColour;
+    }
+
+    void reset() {
+        for (auto& pole : kelletState)
+            for (auto& lane : pole)
+                lane = 0.0f;
+
+        for (auto& row : vossState)
+            for (auto& lane : row)
+                lane = random.nextFloat();
+
+        for (int lane = 0; lane < numStreams; ++lane) {
+            vossSum[lane] = 0.0f;
+            for (int row = 0; row < vossRows; ++row)
+                vossSum[lane] += vossState[row][lane];
+
+            brownState[lane] = 0.0f;
+            previousInput[lane] = 0.0f;
+
+            for (auto& stage : greyState)
+                stage[0][lane] = stage[1][lane] = 0.0f;
+        }
+
+        vossCounter = 1;
+    }
+
+    // Renders numOutputs (1 to numStreams) independent streams of the
+    // current colour side by side. The chunk renderers are instantiated per
+    // stream count, so a single stream costs a single stream's work.
+    void generateBlock(float* const* outputs, int numOutputs, int numSamples) {
+        jassert(numOutputs > 0 && numOutputs <= numStreams);
+
+        switch (numOutputs) {
+        case 1:  generateStreams<1>(outputs, numSamples); break;
+        case 2:  generateStreams<2>(outputs, numSamples); break;
+        case 3:  generateStreams<3>(outputs, numSamples); break;
+        default: generateStreams<4>(outputs, numSamples); break;
+        }
+    }
+
+    // Noise pair with inter-channel correlation rho from two streams, mid M
+    // and side S, at constant power:
+    //     L = cos(t) M + sin(t) S,  R = cos(t) M - sin(t) S,  t = acos(rho) / 2
+    // so corr(L, R) = cos(2t) = rho and both channels keep a single stream's
+    // level. The weights ramp from the previous call's correlation.
+    void generateCorrelatedBlock(float* left, float* right, float correlation, int numSamples) {
+        float* streams[] = { left, right };
+        generateBlock(streams, 2, numSamples);
+
+        auto theta = 0.5f * std::acos(juce::jlimit(-1.0f, 1.0f, correlation));
+        auto midTarget = std::cos(theta);
+        auto sideTarget = std::sin(theta);
+        auto midStep = (midTarget - midGain) / static_cast<float>(numSamples);
+        auto sideStep = (sideTarget - sideGain) / static_cast<float>(numSamples);
+
+        for (int i = 0; i < numSamples; ++i) {
+            midGain += midStep;
+            sideGain += sideStep;
+
+            auto mid = midGain * left[i];
+            auto side = sideGain * right[i];
+            left[i] = mid + side;
+            right[i] = mid - side;
+        }
+
+        midGain = midTarget;
+        sideGain = sideTarget;
+    }
+
+private:
+    FastRandom random;
+    PinkNoiseAlgorithm algorithm = PinkNoiseAlgorithm::Kellet;
+    NoiseColour colour = NoiseColour::Pink;
+
+    // Every colour is scaled to the RMS of the Kellet pink output, so
+    // switching colour changes the spectrum and not the loudness
+    static constexpr float outputLevel = 0.194f;
+    static constexpr float whiteGain = 0.336f;       // outputLevel / sqrt(1/3)
+    static constexpr float violetGain = 0.2376f;     // outputLevel / sqrt(2/3)
+    static constexpr float blueGain = 1.68f;         // measured on differentiated Kellet pink
+
+    // Correlated pair weights, fully correlated until first use
+    float midGain = 1.0f;
+    float sideGain = 0.0f;
+
+    // Interleaved by stream, [sample][stream], for however many streams the
+    // current call renders
+    alignas(GroupRegister::SIMDRegisterSize) float white[chunkSize * numStreams];
+    alignas(GroupRegister::SIMDRegisterSize) float chunkOutput[chunkSize * numStreams];
+
+    // Kellet poles 0-5 are one-pole lowpasses y = a y + c w; the seventh
+    // term is a one-sample FIR (kelletState[6] holds it)
+    static constexpr int kelletPoles = 6;
+    static constexpr float kelletFeedback[kelletPoles] = { 0.99886f, 0.99332f, 0.96900f, 0.86650f, 0.55000f, -0.7616f };
+    static constexpr float kelletInput[kelletPoles] = { 0.0555179f, 0.0750759f, 0.1538520f, 0.3104856f, 0.5329522f, -0.0168980f };
+    static constexpr float kelletDirect = 0.5362f;      // FIR taps on w[n] and w[n - 1]
+    static constexpr float kelletDelayed = 0.115926f;
+    static constexpr float kelletGain = 0.11f;
+
+    float kelletState[7][numStreams];
+
+    // Single-stream Kellet runs one register of samples at a time: sample k
+    // of a group is carry[k] * (the pole's last output) + sum over j of
+    // input[j][k] * w[j]
+    static constexpr int kelletGroup = static_cast<int>(GroupRegister::SIMDNumElements);
+    GroupRegister kelletGroupCarry[kelletPoles];
+    GroupRegister kelletGroupInput[kelletPoles][kelletGroup];
+
+    float vossState[vossRows][numStreams];
+    float vossSum[numStreams];
+    juce::uint32 vossCounter = 1;
+
+    float brownState[numStreams];
+    float brownLeak = 0.0f;
+    float brownGain = 0.0f;
+
+    float previousInput[numStreams];    // differentiator memory for blue / violet
+
+    enum class GreyStage { LowShelf, Peak, HighShelf };
+    struct GreyCoefficients { float b0, b1, b2, a1, a2; };
+    GreyCoefficients greyEq[greyStages];
+    float greyState[greyStages][2][numStreams];     // transposed direct form II
+    float greyGain = 0.0f;
+
+    template <int Streams>
+    void generateStreams(float* const* outputs, int numSamples) {
+        for (int start = 0; start < numSamples; start += chunkSize) {
+            auto count = juce::jmin(chunkSize, numSamples - start);
+
+            renderChunk<Streams>(count);
+
+            for (int stream = 0; stream < Streams; ++stream)
+                for (int i = 0; i < count; ++i)
+                    outputs[stream][start + i] = chunkOutput[i * Streams + stream];
+        }
+    }
+
+    // Filter state is kept per stream in [..][numStreams] arrays; a render of
+    // fewer streams works on a local copy of the first Streams lanes.
+    template <int Streams, int Rows>
+    static void loadLanes(float (&local)[Rows][Streams], const float (&state)[Rows][numStreams]) {
+        for (int row = 0; row < Rows; ++row)
+            for (int lane = 0; lane < Streams; ++lane)
+                local[row][lane] = state[row][lane];
+    }
+
+    template <int Streams, int Rows>
+    static void storeLanes(float (&state)[Rows][numStreams], const float (&local)[Rows][Streams]) {
+        for (int row = 0; row < Rows; ++row)
+            for (int lane = 0; lane < Streams; ++lane)
+                state[row][lane] = local[row][lane];
+    }
+
+    template <int Streams>
+    void renderChunk(int count) {
+        switch (colour) {
+        case NoiseColour::White:  renderWhiteChunk<Streams>(count); break;
+        case NoiseColour::Brown:  renderBrownChunk<Streams>(count); break;
+        case NoiseColour::Blue:   renderPinkChunk<Streams>(count); differentiateChunk<Streams>(chunkOutput, blueGain, count); break;
+        case NoiseColour::Violet: random.generateBlock(white, count * Streams); differentiateChunk<Streams>(white, violetGain, count); break;
+        case NoiseColour::Grey:   renderGreyChunk<Streams>(count); break;
+        default:                  renderPinkChunk<Streams>(count); break;
+        }
+    }
+
+    template <int Streams>
+    void renderPinkChunk(int count) {
+        if (algorithm == PinkNoiseAlgorithm::VossMcCartney)
+            renderVossChunk<Streams>(count);
+        else
+            renderKelletChunk<Streams>(count);
+    }
+
+    template <int Streams>
+    void renderWhiteChunk(int count) {
+        random.generateBlock(white, count * Streams);
+
+        for (int i = 0; i < count * Streams; ++i)
+            chunkOutput[i] = white[i] * whiteGain;
+    }
+
+    // Paul Kellet's refined 7-pole filter, all streams per sample
+    template <int Streams>
+    void renderKelletChunk(int count) {
+        if constexpr (Streams == 1) {
+            renderKelletSingle(count);
+            return;
+        }
+
+        random.generateBlock(white, count * Streams);
+
+        // Local copy keeps the filter state in registers across the chunk
+        float b[7][Streams];
+        loadLanes(b, kelletState);
+
+        for (int i = 0; i < count; ++i) {
+            auto* w = white + i * Streams;
+            auto* out = chunkOutput + i * Streams;
+
+            // Lanes innermost, so each pole is one vector operation
+            for (int pole = 0; pole < kelletPoles; ++pole)
+                for (int lane = 0; lane < Streams; ++lane)
+                    b[pole][lane] = kelletFeedback[pole] * b[pole][lane] + w[lane] * kelletInput[pole];
+
+            for (int lane = 0; lane < Streams; ++lane) {
+                float sum = b[0][lane] + b[1][lane] + b[2][lane] + b[3][lane]
+                    + b[4][lane] + b[5][lane] + b[6][lane] + w[lane] * kelletDirect;
+                b[6][lane] = w[lane] * kelletDelayed;
+
+                out[lane] = sum * kelletGain;
+            }
+        }
+
+        storeLanes(kelletState, b);
+    }
+
+    // One stream has no lanes to fill, and each pole is a one-sample
+    // recursion, so the poles run a register of samples at a time instead:
+    //
+    //     y[k] = a^(k+1) y[-1] + c * sum_{j <= k} a^(k-j) w[j]
+    //
+    // The samples of a group only depend on the previous group's last
+    // output, so the recursion carries once per group rather than per sample.
+    // A group is one baseline SIMDRegister (four samples with SSE) in every
+    // SimdDispatch tier.
+    void renderKelletSingle(int count) {
+        random.generateBlock(white, count);
+
+        float b[7];
+        for (int pole = 0; pole < 7; ++pole)
+            b[pole] = kelletState[pole][0];
+
+        // Direct and one-sample-delayed white terms for every sample first
+        chunkOutput[0] = b[6] + white[0] * kelletDirect;
+        for (int i = 1; i < count; ++i)
+            chunkOutput[i] = white[i - 1] * kelletDelayed + white[i] * kelletDirect;
+        if (count > 0)
+            b[6] = white[count - 1] * kelletDelayed;
+
+        int i = 0;
+        for (; i + kelletGroup <= count; i += kelletGroup) {
+            GroupRegister w[kelletGroup];
+            for (int j = 0; j < kelletGroup; ++j)
+                w[j] = GroupRegister::expand(white[i + j]);
+
+            auto sum = GroupRegister::fromRawArray(chunkOutput + i);
+
+            for (int pole = 0; pole < kelletPoles; ++pole) {
+                // The input part does not wait on the previous group
+                auto y = kelletGroupInput[pole][0] * w[0];
+                for (int j = 1; j < kelletGroup; ++j)
+                    y += kelletGroupInput[pole][j] * w[j];
+
+                y += kelletGroupCarry[pole] * GroupRegister::expand(b[pole]);
+                sum += y;
+                b[pole] = y.get(static_cast<size_t>(kelletGroup - 1));
+            }
+
+            (sum * kelletGain).copyToRawArray(chunkOutput + i);
+        }
+
+        // Leftover samples one at a time
+        for (; i < count; ++i) {
+            auto w = white[i];
+            float sum = chunkOutput[i];
+
+            for (int pole = 0; pole < kelletPoles; ++pole) {
+                b[pole] = kelletFeedback[pole] * b[pole] + w * kelletInput[pole];
+                sum += b[pole];
+            }
+
+            chunkOutput[i] = sum * kelletGain;
+        }
+
+        for (int pole = 0; pole < 7; ++pole)
+            kelletState[pole][0] = b[pole];
+    }
+
+    void designKelletGroups() {
+        for (int pole = 0; pole < kelletPoles; ++pole) {
+            auto a = static_cast<double>(kelletFeedback[pole]);
+            auto c = static_cast<double>(kelletInput[pole]);
+
+            for (int k = 0; k < kelletGroup; ++k) {
+                auto lane = static_cast<size_t>(k);
+                kelletGroupCarry[pole].set(lane, static_cast<float>(std::pow(a, k + 1)));
+
+                for (int j = 0; j < kelletGroup; ++j)
+                    kelletGroupInput[pole][j].set(lane, j <= k ? static_cast<float>(c * std::pow(a, k - j)) : 0.0f);
+            }
+        }
+    }
+
+    // Voss-McCartney: row k is redrawn every 2^(k+1) samples, staggered so
+    // exactly one row changes per sample. One random number and two adds per
+    // sample instead of seven filter poles.
+    template <int Streams>
+    void renderVossChunk(int count) {
+        random.generateBlock(white, count * Streams);
+
+        for (int i = 0; i < count; ++i) {
+            auto* w = white + i * Streams;
+            auto* out = chunkOutput + i * Streams;
+
+            int row = 0;
+            for (auto bits = vossCounter; (bits & 1u) == 0 && row < vossRows - 1; bits >>= 1)
+                ++row;
+            ++vossCounter;
+
+            for (int lane = 0; lane < Streams; ++lane) {
+                vossSum[lane] += w[lane] - vossState[row][lane];
+                vossState[row][lane] = w[lane];
+                out[lane] = vossSum[lane] * vossGain;
+            }
+        }
+    }
+
+    static constexpr float vossGain = 0.095f;  // matches the Kellet level across the audible band
+
+    // Leaky integrator: -6 dB/oct above the 8 Hz leak corner
+    template <int Streams>
+    void renderBrownChunk(int count) {
+        random.generateBlock(white, count * Streams);
+
+        float y[Streams];
+        std::memcpy(y, brownState, sizeof(y));
+
+        for (int i = 0; i < count; ++i) {
+            auto* w = white + i * Streams;
+            auto* out = chunkOutput + i * Streams;
+
+            for (int lane = 0; lane < Streams; ++lane) {
+                y[lane] = brownLeak * y[lane] + w[lane];
+                out[lane] = y[lane] * brownGain;
+            }
+        }
+
+        std::memcpy(brownState, y, sizeof(y));
+    }
+
+    // First difference x[n] - x[n-1] into chunkOutput: +6 dB/oct. input may
+    // be chunkOutput itself.
+    template <int Streams>
+    void differentiateChunk(const float* input, float gain, int count) {
+        float previous[Streams];
+        std::memcpy(previous, previousInput, sizeof(previous));
+
+        for (int i = 0; i < count; ++i) {
+            auto* x = input + i * Streams;
+            auto* out = chunkOutput + i * Streams;
+
+            for (int lane = 0; lane < Streams; ++lane) {
+                auto current = x[lane];
+                out[lane] = (current - previous[lane]) * gain;
+                previous[lane] = current;
+            }
+        }
+
+        std::memcpy(previousInput, previous, sizeof(previous));
+    }
+
+    // White through the grey EQ cascade
+    template <int Streams>
+    void renderGreyChunk(int count) {
+        random.generateBlock(chunkOutput, count * Streams);
+
+        for (int stage = 0; stage < greyStages; ++stage) {
+            auto c = greyEq[stage];
+            float z1[Streams], z2[Streams];
+            std::memcpy(z1, greyState[stage][0], sizeof(z1));
+            std::memcpy(z2, greyState[stage][1], sizeof(z2));
+
+            for (int i = 0; i < count; ++i) {
+                auto* x = chunkOutput + i * Streams;
+
+                for (int lane = 0; lane < Streams; ++lane) {
+                    auto in = x[lane];
+                    auto out = c.b0 * in + z1[lane];
+                    z1[lane] = c.b1 * in - c.a1 * out + z2[lane];
+                    z2[lane] = c.b2 * in - c.a2 * out;
+                    x[lane] = out;
+                }
+            }
+
+            std::memcpy(greyState[stage][0], z1, sizeof(z1));
+            std::memcpy(greyState[stage][1], z2, sizeof(z2));
+        }
+
+        for (int i = 0; i < count * Streams; ++i)
+            chunkOutput[i] *= greyGain;
+    }
+
+    // RBJ cookbook shelves and peak
+    static void designGreyStage(GreyCoefficients& c, double sampleRate, GreyStage type,
+        double frequency, double gainDb, double Q) {
+        auto A = std::pow(10.0, gainDb / 40.0);
+        auto w0 = juce::MathConstants<double>::twoPi * juce::jmin(frequency, 0.45 * sampleRate) / sampleRate;
+        auto cosw0 = std::cos(w0);
+        auto alpha = std::sin(w0) / (2.0 * Q);
+        auto shelfAlpha = 2.0 * std::sqrt(A) * alpha;
+
+        double b0, b1, b2, a0, a1, a2;
+
+        if (type == GreyStage::LowShelf) {
+            b0 = A * ((A + 1.0) - (A - 1.0) * cosw0 + shelfAlpha);
+            b1 = 2.0 * A * ((A - 1.0) - (A + 1.0) * cosw0);
+            b2 = A * ((A + 1.0) - (A - 1.0) * cosw0 - shelfAlpha);
+            a0 = (A + 1.0) + (A - 1.0) * cosw0 + shelfAlpha;
+            a1 = -2.0 * ((A - 1.0) + (A + 1.0) * cosw0);
+            a2 = (A + 1.0) + (A - 1.0) * cosw0 - shelfAlpha;
+        }
+        else if (type == GreyStage::HighShelf) {
+            b0 = A * ((A + 1.0) + (A - 1.0) * cosw0 + shelfAlpha);
+            b1 = -2.0 * A * ((A - 1.0) + (A + 1.0) * cosw0);
+            b2 = A * ((A + 1.0) + (A - 1.0) * cosw0 - shelfAlpha);
+            a0 = (A + 1.0) - (A - 1.0) * cosw0 + shelfAlpha;
+            a1 = 2.0 * ((A - 1.0) - (A + 1.0) * cosw0);
+            a2 = (A + 1.0) - (A - 1.0) * cosw0 - shelfAlpha;
+        }
+        else {
+            b0 = 1.0 + alpha * A;
+            b1 = -2.0 * cosw0;
+            b2 = 1.0 - alpha * A;
+            a0 = 1.0 + alpha / A;
+            a1 = -2.0 * cosw0;
+            a2 = 1.0 - alpha / A;
+        }
+
+        c = { static_cast<float>(b0 / a0), static_cast<float>(b1 / a0), static_cast<float>(b2 / a0),
+              static_cast<float>(a1 / a0), static_cast<float>(a2 / a0) };
+    }
+
+    // Sum of the squared impulse response of the grey cascade
+    float greyPowerGain() const {
+        double z[greyStages][2] = {};
+        double energy = 0.0;
+
+        for (int n = 0; n < 32768; ++n) {
+            double x = n == 0 ? 1.0 : 0.0;
+
+            for (int stage = 0; stage < greyStages; ++stage) {
+                auto& c = greyEq[stage];
+                auto y = c.b0 * x + z[stage][0];
+                z[stage][0] = c.b1 * x - c.a1 * y + z[stage][1];
+                z[stage][1] = c.b2 * x - c.a2 * y;
+                x = y;
+            }
+
+            energy += x * x;
+        }
+
+        return static_cast<float>(energy);
+    }
+};
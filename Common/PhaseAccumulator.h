@@ -0,0 +1,57 @@
+#pragma once
+#include <JuceHeader.h>
+#include <cmath>
+
+// ============================================================================
+// FIXED-POINT PHASE
+// ============================================================================
+//
+// Every oscillator and LFO phase is an unsigned 32-bit fraction of a cycle:
+// 2^32 is one full cycle, so the accumulator wraps by integer overflow with
+// no compare or subtract, and its resolution (2.3e-10 cycles) is the same
+// after an hour as after a second. The top bits of a phase index a table of
+// 2^Bits points directly and the bits below them are the interpolation
+// fraction; FastMath::sinPhase takes a phase as it is.
+//
+// Floats only appear at the edges: turning a frequency into an increment and
+// reading a phase back in cycles for shapes computed from it.
+
+namespace Phase {
+
+using Type = juce::uint32;
+
+constexpr int bits = 32;
+constexpr Type halfCycle = 0x80000000u;
+constexpr Type quarterCycle = 0x40000000u;
+
+// Any value in cycles, wrapped to [0, 1) and rounded to the nearest step.
+// For setters and per-block updates.
+inline Type fromCycles(double cycles) {
+    auto fraction = cycles - std::floor(cycles);
+    return static_cast<Type>(static_cast<juce::uint64>(std::llround(fraction * 4294967296.0)));
+}
+
+// Per-sample increment in cycles, |increment| < 2^31; negative values run
+// the phase backwards. Truncates, so it is cheap enough for ramps.
+inline Type fromIncrement(float increment) {
+    return static_cast<Type>(static_cast<juce::int64>(increment * 4294967296.0f));
+}
+
+// [0, 1) in cycles. The top 24 bits convert to float exactly.
+inline float toCycles(Type phase) {
+    return static_cast<float>(phase >> 8) * (1.0f / 16777216.0f);
+}
+
+// Table position for a table of 2^Bits points per cycle
+template <int Bits>
+inline int index(Type phase) {
+    return static_cast<int>(phase >> (bits - Bits));
+}
+
+template <int Bits>
+inline float fraction(Type phase) {
+    constexpr Type mask = (Type(1) << (bits - Bits)) - 1;
+    return static_cast<float>(phase & mask) * (1.0f / static_cast<float>(mask + 1));
+}
+
+} // namespace Phase
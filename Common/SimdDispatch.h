@@ -0,0 +1,95 @@
+#pragma once
+#include <JuceHeader.h>
+
+// ============================================================================
+// RUNTIME INSTRUCTION-SET DISPATCH
+// ============================================================================
+//
+// The processing kernels are compiled once per tier and the tier is picked in
+// prepareToPlay from what the CPU reports, so one binary uses AVX2 or AVX-512
+// where they exist and still runs on SSE2-only machines. A tier's entry point
+// is a flattened wrapper carrying the tier's target attribute: everything it
+// calls (oscillators, noise, LFOs, biquad lanes) is inlined into it and
+// compiled for that instruction set.
+//
+// Only the plain loops the compiler auto-vectorises get wider: the gain
+// ramps, mixes, oscillator and noise loops. Code written on
+// juce::dsp::SIMDRegister (BiquadLanes, the single-stream Kellet groups in
+// NoiseGenerator) keeps the register width of the project's baseline
+// flags, four floats with SSE, in every tier.
+//
+// Only the per-sample kernels are wrapped. The per-block bookkeeping around
+// them (detectors, smoothers, meters) measured slower when built for AVX and
+// stays on the baseline.
+//
+// Setting BRAINWAVE_SIMD_TIER=sse2|avx2|avx512 in the environment forces a
+// tier, e.g. to compare them in the benchmark. A tier the CPU cannot run
+// falls back to the best one it can.
+//
+// Dispatch needs GCC or Clang on x86. Other builds have only the baseline
+// tier, compiled for whatever the project targets.
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BRAINWAVE_SIMD_DISPATCH 1
+#define BRAINWAVE_TARGET_AVX2 __attribute__((target("avx2,fma"), flatten))
+#define BRAINWAVE_TARGET_AVX512 __attribute__((target("avx512f,avx512vl,avx512dq,avx512bw,avx2,fma"), flatten))
+#else
+#define BRAINWAVE_SIMD_DISPATCH 0
+#endif
+
+enum class SimdTier {
+    Baseline = 0,       // SSE2 on x86-64
+    Avx2,               // AVX2 + FMA
+    Avx512,             // AVX-512 F / VL / DQ / BW
+    NumTiers
+};
+
+namespace SimdDispatch {
+
+constexpr size_t numTiers = static_cast<size_t>(SimdTier::NumTiers);
+
+inline const char* getName(SimdTier tier) {
+    switch (tier) {
+    case SimdTier::Avx2:   return "avx2";
+    case SimdTier::Avx512: return "avx512";
+    default:               return "sse2";
+    }
+}
+
+inline bool isSupported(SimdTier tier) {
+#if BRAINWAVE_SIMD_DISPATCH
+    using juce::SystemStats;
+
+    switch (tier) {
+    case SimdTier::Avx2:
+        return SystemStats::hasAVX2() && SystemStats::hasFMA3();
+    case SimdTier::Avx512:
+        return isSupported(SimdTier::Avx2) && SystemStats::hasAVX512F() && SystemStats::hasAVX512VL()
+            && SystemStats::hasAVX512DQ() && SystemStats::hasAVX512BW();
+    default:
+        return true;
+    }
+#else
+    return tier == SimdTier::Baseline;
+#endif
+}
+
+// The best supported tier, unless BRAINWAVE_SIMD_TIER names another supported one
+inline SimdTier selectTier() {
+    auto best = SimdTier::Baseline;
+    for (auto tier : { SimdTier::Avx2, SimdTier::Avx512 })
+        if (isSupported(tier))
+            best = tier;
+
+    auto forced = juce::SystemStats::getEnvironmentVariable("BRAINWAVE_SIMD_TIER", {}).trim().toLowerCase();
+
+    for (size_t i = 0; i < numTiers; ++i) {
+        auto tier = static_cast<SimdTier>(i);
+        if (forced == getName(tier))
+            return isSupported(tier) ? tier : best;
+    }
+
+    return best;
+}
+
+} // namespace SimdDispatch
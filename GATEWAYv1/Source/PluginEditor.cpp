@@ -172,6 +172,8 @@ BrainwaveEntrainmentAudioProcessorEditor::BrainwaveEntrainmentAudioProcessorEdit
     rmsLabel.setJustificationType(juce::Justification::centredRight);
     addAndMakeVisible(rmsLabel);
 
+    // Frames queued while no editor was open are stale
+    audioProcessor.getMeterRing().skipAll();
     startTimerHz(30);
 }
 
@@ -291,10 +293,16 @@ void BrainwaveEntrainmentAudioProcessorEditor::timerCallback() {
     float beatHz = audioProcessor.getCurrentBeatFrequency();
     beatLabel.setText("Beat: " + juce::String(beatHz, 2) + " Hz", juce::dontSendNotification);
 
-    // Update RMS monitoring
-    float leftRMS = audioProcessor.getLeftRMSLevel();
-    float rightRMS = audioProcessor.getRightRMSLevel();
-    float avgRMS = (leftRMS + rightRMS) * 0.5f;
+    // RMS over every block since the last tick
+    double outputEnergy = 0.0;
+    int numSamples = 0;
+
+    audioProcessor.getMeterRing().drain([&](const MeterFrame& frame) {
+        outputEnergy += 0.5 * (frame.rmsLeft * frame.rmsLeft + frame.rmsRight * frame.rmsRight) * frame.numSamples;
+        numSamples += frame.numSamples;
+    });
+
+    auto avgRMS = numSamples > 0 ? static_cast<float>(std::sqrt(outputEnergy / numSamples)) : 0.0f;
 
     if (avgRMS > 0.0001f) {
         float splApprox = 20.0f * std::log10(avgRMS) + 94.0f;
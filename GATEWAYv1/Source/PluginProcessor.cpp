@@ -1,6 +1,53 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+#if BRAINWAVE_CHECK_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+
+// Replacement global allocation functions, so ScopedNoAllocations can see
+// every heap allocation (see AllocationCheck.h)
+void* operator new(std::size_t size) {
+    AllocationCheck::noteAllocation();
+
+    if (auto* memory = std::malloc(size > 0 ? size : 1))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+// GCC flags the inlined free() as not matching operator new, not knowing
+// this file replaces both
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+void operator delete[](void* memory) noexcept {
+    operator delete(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    operator delete(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    operator delete(memory);
+}
+#endif
+
 // ============================================================================
 // AUDIO PROCESSOR EDITOR IMPLEMENTATION
 // ============================================================================
@@ -19,30 +66,23 @@ BrainwaveEntrainmentAudioProcessor::BrainwaveEntrainmentAudioProcessor()
         .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
     parameters(*this, nullptr, "Parameters", createParameterLayout()) {
 
-    // Add parameter listeners
-    parameters.addParameterListener("brainwave_frequency", this);
-    parameters.addParameterListener("entrainment_mode", this);
-    parameters.addParameterListener("carrier_frequency", this);
-    parameters.addParameterListener("solfeggio_preset", this);
-    parameters.addParameterListener("beat_offset", this);
-    parameters.addParameterListener("waveform", this);
-    parameters.addParameterListener("wet_mix", this);
-    parameters.addParameterListener("modulation_depth", this);
-    parameters.addParameterListener("hemisync_correlation", this);
-    parameters.addParameterListener("hemisync_drift", this);
+    // Parameters read every block, so the audio thread never looks them up by name
+    paramPointers.noiseAmount = parameters.getRawParameterValue("noise_amount");
+    paramPointers.hemiDrift = parameters.getRawParameterValue("hemisync_drift");
+    paramPointers.hemiCorrelation = parameters.getRawParameterValue("hemisync_correlation");
+    paramPointers.masterGain = parameters.getRawParameterValue("master_gain");
+
+    // Listener-driven settings
+    for (int i = 0; i < numParameterTargets; ++i) {
+        auto* id = getParameterId(static_cast<ParameterTarget>(i));
+        targetValues[static_cast<size_t>(i)] = parameters.getRawParameterValue(id);
+        parameters.addParameterListener(id, this);
+    }
 }
 
 BrainwaveEntrainmentAudioProcessor::~BrainwaveEntrainmentAudioProcessor() {
-    parameters.removeParameterListener("brainwave_frequency", this);
-    parameters.removeParameterListener("entrainment_mode", this);
-    parameters.removeParameterListener("carrier_frequency", this);
-    parameters.removeParameterListener("solfeggio_preset", this);
-    parameters.removeParameterListener("beat_offset", this);
-    parameters.removeParameterListener("waveform", this);
-    parameters.removeParameterListener("wet_mix", this);
-    parameters.removeParameterListener("modulation_depth", this);
-    parameters.removeParameterListener("hemisync_correlation", this);
-    parameters.removeParameterListener("hemisync_drift", this);
+    for (int i = 0; i < numParameterTargets; ++i)
+        parameters.removeParameterListener(getParameterId(static_cast<ParameterTarget>(i)), this);
 }
 
 // ============================================================================
@@ -66,10 +106,27 @@ void BrainwaveEntrainmentAudioProcessor::prepareToPlay(double sr, int samplesPer
     leftFilter.setLowpass(sr, 2000.0f, 0.707f);
     rightFilter.setLowpass(sr, 2400.0f, 0.707f);
 
-    // Initialize entrainment buffer
-    entrainmentBuffer.setSize(2, samplesPerBlock);
-
-    updateFrequencies();
+    // Gate curves are cubic between control points; drift is slow enough for lines
+    gateLfo.setSampleRate(sr);
+    gateLfo.setControlInterval(32);
+    driftLfo.setSampleRate(sr);
+    driftLfo.setControlInterval(64);
+    driftLfo.setInterpolation(ControlRateLfo<MathTier::driftLfo>::Interpolation::Linear);
+
+    // Scratch for one processing chunk, whatever block size the host sends
+    juce::ignoreUnused(samplesPerBlock);
+    entrainmentBuffer.setSize(2, processingChunkSize);
+
+    // Nothing is rendering yet: take every listener-driven setting as it is now
+    commandQueue.drain([](const ParameterCommand&) {});
+    commandQueue.checkAndClearOverflow();
+    applyAllParameters();
+
+    // Start at the current settings rather than gliding to them
+    currentBeatHz.setCurrentAndTargetValue(currentBeatHz.getTargetValue());
+    carrierHz.setCurrentAndTargetValue(carrierHz.getTargetValue());
+    wetMixSmooth.setCurrentAndTargetValue(wetMixSmooth.getTargetValue());
+    modulationDepthSmooth.setCurrentAndTargetValue(modulationDepthSmooth.getTargetValue());
 }
 
 void BrainwaveEntrainmentAudioProcessor::releaseResources() {
@@ -79,7 +136,26 @@ void BrainwaveEntrainmentAudioProcessor::releaseResources() {
 void BrainwaveEntrainmentAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     juce::MidiBuffer& midiMessages) {
     juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+void BrainwaveEntrainmentAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer,
+    juce::MidiBuffer& midiMessages) {
+    juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+// Shared by both precisions: the entrainment signal is always rendered in
+// float, and only the host's audio is carried as SampleType
+template <typename SampleType>
+void BrainwaveEntrainmentAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer) {
     juce::ScopedNoDenormals noDenormals;
+    ScopedNoAllocations noAllocations;
+
+    // Settings changed since the last block all land before it is rendered
+    commandQueue.drain([this](const ParameterCommand& command) { applyCommand(command); });
+    if (commandQueue.checkAndClearOverflow())
+        applyAllParameters();
 
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -96,29 +172,41 @@ void BrainwaveEntrainmentAudioProcessor::processBlock(juce::AudioBuffer<float>&
         }
     }
 
-    // Generate entrainment signal
-    entrainmentBuffer.clear();
-    applyEntrainmentToInput(buffer);
+    auto snapshot = takeSnapshot();
+
+    // Generate entrainment signal in fixed chunks, each a view onto the
+    // host buffer, so the scratch buffer never needs more than one chunk
+    auto numChannels = juce::jmin(buffer.getNumChannels(), 2);
+    SampleType* chunkChannels[2] = {};
+    blockMeters.reset();
+
+    for (int start = 0; start < buffer.getNumSamples(); start += processingChunkSize) {
+        auto chunkSize = juce::jmin(processingChunkSize, buffer.getNumSamples() - start);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            chunkChannels[channel] = buffer.getWritePointer(channel, start);
+
+        juce::AudioBuffer<SampleType> chunk(chunkChannels, numChannels, chunkSize);
+        entrainmentBuffer.clear();
+        applyEntrainmentToInput(chunk, snapshot);
+    }
+
+    meterRing.push(blockMeters.getFrame());
 
     // Apply master gain
-    auto masterGain = parameters.getRawParameterValue("master_gain")->load();
-    auto gainLinear = juce::Decibels::decibelsToGain(masterGain);
+    auto gainLinear = juce::Decibels::decibelsToGain(static_cast<SampleType>(snapshot.masterGainDb));
     buffer.applyGain(gainLinear);
 }
 
-void BrainwaveEntrainmentAudioProcessor::applyEntrainmentToInput(juce::AudioBuffer<float>& buffer) {
+template <typename SampleType>
+void BrainwaveEntrainmentAudioProcessor::applyEntrainmentToInput(juce::AudioBuffer<SampleType>& buffer, const ParamSnapshot& snapshot) {
     auto numSamples = buffer.getNumSamples();
     auto numChannels = juce::jmin(buffer.getNumChannels(), 2); // Fixed: Added juce:: namespace
 
     // Get current parameter values
-    auto wetMix = wetMixSmooth.getNextValue();
-    auto noiseAmount = parameters.getRawParameterValue("noise_amount")->load();
-    auto hemiDrift = parameters.getRawParameterValue("hemisync_drift")->load();
-    correlationAmount = parameters.getRawParameterValue("hemisync_correlation")->load();
-
-    // RMS accumulators
-    float leftAccum = 0.0f;
-    float rightAccum = 0.0f;
+    auto noiseAmount = snapshot.noiseAmount;
+    auto hemiDrift = snapshot.hemiDrift;
+    correlationAmount = snapshot.hemiCorrelation;
 
     // Generate entrainment signal
     for (int sample = 0; sample < numSamples; ++sample) {
@@ -126,8 +214,6 @@ void BrainwaveEntrainmentAudioProcessor::applyEntrainmentToInput(juce::AudioBuff
         float carrier = carrierHz.getNextValue();
         float modDepthSmooth = modulationDepthSmooth.getNextValue();
 
-        float time = static_cast<float>(sample) / static_cast<float>(sampleRate);
-
         float leftEntrainment = 0.0f;
         float rightEntrainment = 0.0f;
 
@@ -135,19 +221,15 @@ void BrainwaveEntrainmentAudioProcessor::applyEntrainmentToInput(juce::AudioBuff
         // BILATERAL SYNC MODE
         // ====================================================================
         if (currentMode == EntrainmentMode::BilateralSync) {
-            sharedPhase += carrier / static_cast<float>(sampleRate);
-            if (sharedPhase >= 1.0f) sharedPhase -= 1.0f;
-
-            driftPhase += (0.02f * hemiDrift) / static_cast<float>(sampleRate);
-            if (driftPhase >= 1.0f) driftPhase -= 1.0f;
+            sharedPhase += Phase::fromIncrement(carrier / static_cast<float>(sampleRate));
 
-            float driftModulation = std::sin(driftPhase * juce::MathConstants<float>::twoPi) * 0.1f;
+            float driftModulation = driftLfo.process(0.02f * hemiDrift) * 0.1f;
 
-            float leftPhase = sharedPhase + (beatHz * 0.5f / carrier) + driftModulation;
-            float rightPhase = sharedPhase - (beatHz * 0.5f / carrier) - driftModulation;
+            // Left and right are the shared phase split by +/- offset
+            auto offset = Phase::fromIncrement(beatHz * 0.5f / carrier + driftModulation);
 
-            float leftCarrier = std::sin(leftPhase * juce::MathConstants<float>::twoPi);
-            float rightCarrier = std::sin(rightPhase * juce::MathConstants<float>::twoPi);
+            float leftCarrier = FastMath::sinPhase<MathTier::oscillator>(sharedPhase + offset);
+            float rightCarrier = FastMath::sinPhase<MathTier::oscillator>(sharedPhase - offset);
 
             float sharedNoise = noiseGen.generatePink();
             float independentNoise = noiseGen.generatePink();
@@ -160,7 +242,7 @@ void BrainwaveEntrainmentAudioProcessor::applyEntrainmentToInput(juce::AudioBuff
             leftEntrainment = leftCarrier * (1.0f - noiseAmount) + leftNoise * noiseAmount;
             rightEntrainment = rightCarrier * (1.0f - noiseAmount) + rightNoise * noiseAmount;
 
-            float am = 0.5f * (1.0f + std::sin(juce::MathConstants<float>::twoPi * beatHz * time));
+            float am = 0.5f * (1.0f + gateLfo.process(beatHz));
             am = juce::jlimit(0.0f, 1.0f, am * modDepthSmooth * 0.3f + 0.7f);
 
             leftEntrainment *= am;
@@ -176,8 +258,7 @@ void BrainwaveEntrainmentAudioProcessor::applyEntrainmentToInput(juce::AudioBuff
             float leftTone = 0.0f;
             float rightTone = 0.0f;
 
-            sharedPhase += carrier / static_cast<float>(sampleRate);
-            if (sharedPhase >= 1.0f) sharedPhase -= 1.0f;
+            sharedPhase += Phase::fromIncrement(carrier / static_cast<float>(sampleRate));
 
             switch (currentMode) {
             case EntrainmentMode::Binaural: {
@@ -200,7 +281,7 @@ void BrainwaveEntrainmentAudioProcessor::applyEntrainmentToInput(juce::AudioBuff
             case EntrainmentMode::Isochronic: {
                 carrierOsc.setFrequency(carrier);
                 float tone = carrierOsc.process();
-                float gate = 0.5f * (1.0f + std::sin(juce::MathConstants<float>::twoPi * beatHz * time));
+                float gate = 0.5f * (1.0f + gateLfo.process(beatHz));
                 gate = juce::jlimit(0.0f, 1.0f, gate * modDepthSmooth);
                 leftTone = tone * gate;
                 rightTone = tone * gate;
@@ -213,7 +294,7 @@ void BrainwaveEntrainmentAudioProcessor::applyEntrainmentToInput(juce::AudioBuff
                 leftTone = leftModOsc.process();
                 rightTone = rightModOsc.process();
 
-                float gate = 0.5f * (1.0f + std::sin(juce::MathConstants<float>::twoPi * beatHz * time));
+                float gate = 0.5f * (1.0f + gateLfo.process(beatHz));
                 gate = juce::jlimit(0.0f, 1.0f, gate * modDepthSmooth * 0.5f + 0.5f);
                 leftTone *= gate;
                 rightTone *= gate;
@@ -245,22 +326,23 @@ void BrainwaveEntrainmentAudioProcessor::applyEntrainmentToInput(juce::AudioBuff
         auto* entrainmentData = entrainmentBuffer.getReadPointer(channel);
 
         for (int sample = 0; sample < numSamples; ++sample) {
-            float wet = wetMixSmooth.getNextValue();
-            float dry = 1.0f - wet;
+            auto wet = static_cast<SampleType>(wetMixSmooth.getNextValue());
+            auto dry = SampleType(1) - wet;
 
             inputData[sample] = (inputData[sample] * dry) + (entrainmentData[sample] * wet);
-
-            // Accumulate for RMS
-            if (channel == 0) leftAccum += inputData[sample] * inputData[sample];
-            if (channel == 1) rightAccum += inputData[sample] * inputData[sample];
         }
     }
 
-    // Calculate RMS
-    if (numSamples > 0) {
-        leftRMS = std::sqrt(leftAccum / static_cast<float>(numSamples));
-        rightRMS = std::sqrt(rightAccum / static_cast<float>(numSamples));
-    }
+    // Levels for the editor's meters, pushed once the whole block is done
+    MeterFrame meters;
+    meters.peakLeft = static_cast<float>(buffer.getMagnitude(0, 0, numSamples));
+    meters.peakRight = static_cast<float>(buffer.getMagnitude(numChannels - 1, 0, numSamples));
+    meters.rmsLeft = static_cast<float>(buffer.getRMSLevel(0, 0, numSamples));
+    meters.rmsRight = static_cast<float>(buffer.getRMSLevel(numChannels - 1, 0, numSamples));
+    meters.entrainment = 0.5f * (entrainmentBuffer.getRMSLevel(0, 0, numSamples)
+        + entrainmentBuffer.getRMSLevel(1, 0, numSamples));
+    meters.numSamples = numSamples;
+    blockMeters.add(meters);
 }
 
 // ============================================================================
@@ -268,34 +350,101 @@ void BrainwaveEntrainmentAudioProcessor::applyEntrainmentToInput(juce::AudioBuff
 // ============================================================================
 
 void BrainwaveEntrainmentAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue) {
-    if (parameterID == "brainwave_frequency") {
+    for (int i = 0; i < numParameterTargets; ++i) {
+        auto target = static_cast<ParameterTarget>(i);
+
+        if (parameterID == getParameterId(target)) {
+            commandQueue.push({ target, newValue });
+            return;
+        }
+    }
+}
+
+const char* BrainwaveEntrainmentAudioProcessor::getParameterId(ParameterTarget target) {
+    switch (target) {
+    case ParameterTarget::BrainwaveFrequency: return "brainwave_frequency";
+    case ParameterTarget::EntrainmentMode:    return "entrainment_mode";
+    case ParameterTarget::CarrierFrequency:   return "carrier_frequency";
+    case ParameterTarget::SolfeggioPreset:    return "solfeggio_preset";
+    case ParameterTarget::BeatOffset:         return "beat_offset";
+    case ParameterTarget::Waveform:           return "waveform";
+    case ParameterTarget::WetMix:             return "wet_mix";
+    case ParameterTarget::ModulationDepth:    return "modulation_depth";
+    default: break;
+    }
+
+    return "";
+}
+
+// Audio thread (or prepareToPlay, while nothing is rendering)
+void BrainwaveEntrainmentAudioProcessor::applyCommand(const ParameterCommand& command) {
+    auto newValue = command.value;
+
+    switch (command.target) {
+    case ParameterTarget::BrainwaveFrequency:
         currentFrequency = static_cast<BrainwaveFrequency>(static_cast<int>(newValue));
         updateFrequencies();
-    }
-    else if (parameterID == "entrainment_mode") {
+        break;
+
+    case ParameterTarget::EntrainmentMode:
         currentMode = static_cast<EntrainmentMode>(static_cast<int>(newValue));
         updateFrequencies();
-    }
-    else if (parameterID == "carrier_frequency" || parameterID == "solfeggio_preset") {
+        break;
+
+    case ParameterTarget::CarrierFrequency:
+        manualCarrierHz = newValue;
         updateFrequencies();
-    }
-    else if (parameterID == "beat_offset") {
+        break;
+
+    case ParameterTarget::SolfeggioPreset:
+        solfeggioPreset = static_cast<int>(newValue);
         updateFrequencies();
-    }
-    else if (parameterID == "waveform") {
+        break;
+
+    case ParameterTarget::BeatOffset:
+        beatOffset = newValue;
+        updateFrequencies();
+        break;
+
+    case ParameterTarget::Waveform: {
         auto waveform = static_cast<Waveform>(static_cast<int>(newValue));
         carrierOsc.setWaveform(waveform);
         leftModOsc.setWaveform(waveform);
         rightModOsc.setWaveform(waveform);
+        break;
     }
-    else if (parameterID == "wet_mix") {
+
+    case ParameterTarget::WetMix:
         wetMixSmooth.setTargetValue(newValue);
-    }
-    else if (parameterID == "modulation_depth") {
+        break;
+
+    case ParameterTarget::ModulationDepth:
         modulationDepthSmooth.setTargetValue(newValue);
+        break;
+
+    default:
+        break;
     }
 }
 
+// Every listener-driven setting straight from its parameter, for when the
+// queue can't be trusted to hold every change
+void BrainwaveEntrainmentAudioProcessor::applyAllParameters() {
+    for (int i = 0; i < numParameterTargets; ++i)
+        applyCommand({ static_cast<ParameterTarget>(i), targetValues[static_cast<size_t>(i)]->load() });
+}
+
+BrainwaveEntrainmentAudioProcessor::ParamSnapshot BrainwaveEntrainmentAudioProcessor::takeSnapshot() const {
+    ParamSnapshot snapshot;
+
+    snapshot.noiseAmount = paramPointers.noiseAmount->load();
+    snapshot.hemiDrift = paramPointers.hemiDrift->load();
+    snapshot.hemiCorrelation = paramPointers.hemiCorrelation->load();
+    snapshot.masterGainDb = paramPointers.masterGain->load();
+
+    return snapshot;
+}
+
 void BrainwaveEntrainmentAudioProcessor::updateFrequencies() {
     // Get base brainwave frequency
     float baseHz = 1.0f;
@@ -312,9 +461,7 @@ void BrainwaveEntrainmentAudioProcessor::updateFrequencies() {
     case BrainwaveFrequency::Focus21: baseHz = 20.0f; break;
     }
 
-    // Apply solfeggio preset if selected
-    int solfeggioPreset = static_cast<int>(parameters.getRawParameterValue("solfeggio_preset")->load());
-    float carrier = parameters.getRawParameterValue("carrier_frequency")->load();
+    float carrier = manualCarrierHz;
 
     // Override carrier with solfeggio frequency if not manual
     if (solfeggioPreset > 0) {
@@ -332,7 +479,6 @@ void BrainwaveEntrainmentAudioProcessor::updateFrequencies() {
     }
 
     // Add user offset
-    float beatOffset = parameters.getRawParameterValue("beat_offset")->load();
     float finalBeatHz = juce::jlimit(0.5f, 100.0f, baseHz + beatOffset);
 
     currentBeatHz.setTargetValue(finalBeatHz);
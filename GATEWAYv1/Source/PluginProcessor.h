@@ -1,7 +1,26 @@
 #pragma once
 #include <JuceHeader.h>
+#include <array>
 #include <random>
 #include <vector>
+#include "../../Common/FastMath.h"
+#include "../../Common/PhaseAccumulator.h"
+#include "../../Common/FastRandom.h"
+#include "../../Common/ControlRateLfo.h"
+#include "../../Common/CommandQueue.h"
+#include "../../Common/MeterRing.h"
+#include "../../Common/AllocationCheck.h"
+
+// ============================================================================
+// FAST MATH PRECISION PER CALL SITE
+// ============================================================================
+
+namespace MathTier {
+    constexpr auto oscillator = FastMath::Precision::High;         // audible carriers and drum tones
+    constexpr auto amGate = FastMath::Precision::Standard;         // beat-rate gain curves
+    constexpr auto drumEnvelope = FastMath::Precision::Draft;      // decays, masked by the hit itself
+    constexpr auto driftLfo = FastMath::Precision::Draft;          // sub-Hz phase wobble
+}
 
 // ============================================================================
 // ENUMS AND TYPES
@@ -48,8 +67,7 @@ enum class Waveform {
 class BrainwaveOscillator {
 public:
     BrainwaveOscillator()
-        : randomGenerator(std::random_device{}()),
-        randomDistribution(-1.0f, 1.0f) {
+        : random(std::random_device{}()) {
     }
 
     void setSampleRate(double sr) {
@@ -67,63 +85,58 @@ public:
     }
 
     void setPhase(float ph) {
-        phase = ph;
+        phase = Phase::fromCycles(ph);
     }
 
     float getPhase() const {
-        return phase;
+        return Phase::toCycles(phase);
     }
 
+    // The drum envelopes restart with every cycle of the phase
     void reset() {
-        phase = 0.0f;
-        envelopePhase = 0.0f;
+        phase = 0;
     }
 
     float process() {
         float sample = 0.0f;
+        auto cycles = Phase::toCycles(phase);
 
         switch (currentWaveform) {
         case Waveform::Sine:
-            sample = std::sin(phase * juce::MathConstants<float>::twoPi);
+            sample = FastMath::sinPhase<MathTier::oscillator>(phase);
             break;
         case Waveform::Triangle:
-            sample = 2.0f * std::abs(2.0f * (phase - 0.5f)) - 1.0f;
+            sample = 2.0f * std::abs(2.0f * (cycles - 0.5f)) - 1.0f;
             break;
         case Waveform::Sawtooth:
-            sample = 2.0f * phase - 1.0f;
+            sample = 2.0f * cycles - 1.0f;
             break;
         case Waveform::Square:
-            sample = phase < 0.5f ? 1.0f : -1.0f;
+            sample = phase < Phase::halfCycle ? 1.0f : -1.0f;
             break;
         case Waveform::Pulse:
-            sample = (phase < 0.25f) ? 1.0f : -1.0f;
+            sample = (phase < Phase::quarterCycle) ? 1.0f : -1.0f;
             break;
         case Waveform::Noise:
-            sample = randomDistribution(randomGenerator);
+            sample = random.nextFloat();
             break;
         case Waveform::DrumKick:
-            sample = generateDrumKick();
+            sample = generateDrumKick(cycles);
             break;
         case Waveform::DrumSnare:
-            sample = generateDrumSnare();
+            sample = generateDrumSnare(cycles);
             break;
         case Waveform::DrumHatClosed:
-            sample = generateHatClosed();
+            sample = generateHatClosed(cycles);
             break;
         case Waveform::DrumHatOpen:
-            sample = generateHatOpen();
+            sample = generateHatOpen(cycles);
             break;
         default:
-            sample = std::sin(phase * juce::MathConstants<float>::twoPi);
+            sample = FastMath::sinPhase<MathTier::oscillator>(phase);
         }
 
         phase += phaseIncrement;
-        if (phase >= 1.0f) {
-            phase -= 1.0f;
-            envelopePhase = 0.0f;
-        }
-
-        envelopePhase += phaseIncrement;
 
         return sample;
     }
@@ -132,39 +145,37 @@ private:
     Waveform currentWaveform = Waveform::Sine;
     double sampleRate = 44100.0;
     float frequency = 440.0f;
-    float phase = 0.0f;
-    float envelopePhase = 0.0f;
-    float phaseIncrement = 0.0f;
+    Phase::Type phase = 0;
+    Phase::Type phaseIncrement = 0;
 
-    std::mt19937 randomGenerator;
-    std::uniform_real_distribution<float> randomDistribution;
+    FastRandom random;
 
     void updateIncrement() {
-        phaseIncrement = frequency / static_cast<float>(sampleRate);
+        phaseIncrement = Phase::fromIncrement(frequency / static_cast<float>(sampleRate));
     }
 
-    float generateDrumKick() {
-        float pitchEnv = std::exp(-envelopePhase * 15.0f);
-        float ampEnv = std::exp(-envelopePhase * 8.0f);
+    float generateDrumKick(float envelopePhase) {
+        float pitchEnv = FastMath::exp<MathTier::drumEnvelope>(-envelopePhase * 15.0f);
+        float ampEnv = FastMath::exp<MathTier::drumEnvelope>(-envelopePhase * 8.0f);
         float kickFreq = 55.0f + 200.0f * pitchEnv;
-        return std::sin(kickFreq * envelopePhase * juce::MathConstants<float>::twoPi) * ampEnv;
+        return FastMath::sin2pi<MathTier::oscillator>(kickFreq * envelopePhase) * ampEnv;
     }
 
-    float generateDrumSnare() {
-        float ampEnv = std::exp(-envelopePhase * 12.0f);
-        float toneComponent = std::sin(200.0f * envelopePhase * juce::MathConstants<float>::twoPi) * 0.3f;
-        float noiseComponent = randomDistribution(randomGenerator) * 0.7f;
+    float generateDrumSnare(float envelopePhase) {
+        float ampEnv = FastMath::exp<MathTier::drumEnvelope>(-envelopePhase * 12.0f);
+        float toneComponent = FastMath::sin2pi<MathTier::oscillator>(200.0f * envelopePhase) * 0.3f;
+        float noiseComponent = random.nextFloat() * 0.7f;
         return (toneComponent + noiseComponent) * ampEnv;
     }
 
-    float generateHatClosed() {
-        float ampEnv = std::exp(-envelopePhase * 25.0f);
-        return randomDistribution(randomGenerator) * ampEnv * 0.5f;
+    float generateHatClosed(float envelopePhase) {
+        float ampEnv = FastMath::exp<MathTier::drumEnvelope>(-envelopePhase * 25.0f);
+        return random.nextFloat() * ampEnv * 0.5f;
     }
 
-    float generateHatOpen() {
-        float ampEnv = std::exp(-envelopePhase * 8.0f);
-        return randomDistribution(randomGenerator) * ampEnv * 0.4f;
+    float generateHatOpen(float envelopePhase) {
+        float ampEnv = FastMath::exp<MathTier::drumEnvelope>(-envelopePhase * 8.0f);
+        return random.nextFloat() * ampEnv * 0.4f;
     }
 };
 
@@ -175,18 +186,17 @@ private:
 class NoiseGenerator {
 public:
     NoiseGenerator()
-        : randomEngine(std::random_device{}()),
-        distribution(-1.0f, 1.0f) {
+        : random(std::random_device{}()) {
         for (int i = 0; i < 7; ++i)
             pinkState[i] = 0.0f;
     }
 
     float generateWhite() {
-        return distribution(randomEngine);
+        return random.nextFloat();
     }
 
     float generatePink() {
-        float white = distribution(randomEngine);
+        float white = random.nextFloat();
 
         pinkState[0] = 0.99886f * pinkState[0] + white * 0.0555179f;
         pinkState[1] = 0.99332f * pinkState[1] + white * 0.0750759f;
@@ -204,8 +214,7 @@ public:
     }
 
 private:
-    std::mt19937 randomEngine;
-    std::uniform_real_distribution<float> distribution;
+    FastRandom random;
     float pinkState[7];
 };
 
@@ -269,6 +278,8 @@ public:
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -293,17 +304,64 @@ public:
 
     float getCurrentBeatFrequency() const { return currentBeatHz.getCurrentValue(); }
 
-    // Monitoring
-    float getLeftRMSLevel() const { return leftRMS; }
-    float getRightRMSLevel() const { return rightRMS; }
+    // Monitoring: one frame per block, drained by the editor
+    using MeterQueue = MeterRing<256>;
+    MeterQueue& getMeterRing() { return meterRing; }
 
 private:
     void parameterChanged(const juce::String& parameterID, float newValue) override;
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    // Settings driven by parameter listeners. Listeners only enqueue; the
+    // audio thread applies them, so oscillator and smoother state is never
+    // touched from another thread.
+    enum class ParameterTarget {
+        BrainwaveFrequency = 0,
+        EntrainmentMode,
+        CarrierFrequency,
+        SolfeggioPreset,
+        BeatOffset,
+        Waveform,
+        WetMix,
+        ModulationDepth,
+        NumTargets
+    };
+
+    struct ParameterCommand {
+        ParameterTarget target = ParameterTarget::NumTargets;
+        float value = 0.0f;
+    };
+
+    static constexpr int numParameterTargets = static_cast<int>(ParameterTarget::NumTargets);
+
+    static const char* getParameterId(ParameterTarget target);
+    void applyCommand(const ParameterCommand& command);
+    void applyAllParameters();
+
+    // Parameter values for one block, gathered at block start from atomics
+    // resolved once at construction
+    struct ParamSnapshot {
+        float noiseAmount = 0.0f;
+        float hemiDrift = 0.5f;
+        float hemiCorrelation = 0.7f;
+        float masterGainDb = -12.0f;
+    };
+
+    struct ParameterPointers {
+        std::atomic<float>* noiseAmount = nullptr;
+        std::atomic<float>* hemiDrift = nullptr;
+        std::atomic<float>* hemiCorrelation = nullptr;
+        std::atomic<float>* masterGain = nullptr;
+    };
+
+    ParamSnapshot takeSnapshot() const;
+
     void updateFrequencies();
-    void generateEntrainmentSignal(juce::AudioBuffer<float>& buffer, int channel, int startSample, int numSamples);
-    void applyEntrainmentToInput(juce::AudioBuffer<float>& buffer);
+    template <typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer);
+
+    template <typename SampleType>
+    void applyEntrainmentToInput(juce::AudioBuffer<SampleType>& buffer, const ParamSnapshot& snapshot);
 
     // Oscillators
     BrainwaveOscillator carrierOsc;
@@ -317,6 +375,9 @@ private:
 
     // Parameters
     juce::AudioProcessorValueTreeState parameters;
+    ParameterPointers paramPointers;
+    std::array<std::atomic<float>*, numParameterTargets> targetValues{};
+    CommandQueue<ParameterCommand, 256> commandQueue;
 
     // State
     double sampleRate = 44100.0;
@@ -328,20 +389,31 @@ private:
     juce::SmoothedValue<float> wetMixSmooth{ 0.5f };
     juce::SmoothedValue<float> modulationDepthSmooth{ 0.8f };
 
+    // Beat-rate gain curve (Isochronic, Hybrid, Bilateral Sync AM), phase
+    // continuous across blocks
+    ControlRateLfo<MathTier::amGate> gateLfo;
+
     // Bilateral Sync specific
-    float sharedPhase = 0.0f;
-    float driftPhase = 0.0f;
+    Phase::Type sharedPhase = 0;
+    ControlRateLfo<MathTier::driftLfo> driftLfo;
     float correlationAmount = 1.0f;
 
-    // Current settings
+    // Current settings, applied from commands
     EntrainmentMode currentMode = EntrainmentMode::Binaural;
     BrainwaveFrequency currentFrequency = BrainwaveFrequency::Alpha;
+    float manualCarrierHz = 400.0f;
+    int solfeggioPreset = 0;
+    float beatOffset = 0.0f;
 
     // Monitoring
-    float leftRMS = 0.0f;
-    float rightRMS = 0.0f;
+    MeterQueue meterRing;
+    MeterAccumulator blockMeters;       // the chunks of the current block
+
+    // Host blocks are processed in chunks of at most this many samples, so the
+    // scratch buffer below is sized once in prepareToPlay
+    static constexpr int processingChunkSize = 64;
 
-    // Buffer for generated entrainment signal
+    // Buffer for generated entrainment signal, one chunk long
     juce::AudioBuffer<float> entrainmentBuffer;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BrainwaveEntrainmentAudioProcessor)
@@ -0,0 +1,121 @@
+#pragma once
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+// BLOCK PARAMETER SMOOTHING
+// ============================================================================
+//
+// Linear smoothing with the same behaviour as juce::SmoothedValue, but asked
+// for a whole block at once. Most blocks have no ramp in them; those come
+// back as a constant and nothing is written, so kernels can take their
+// cheapest path. A block that ramps is filled in one loop of
+//
+//     ramp[i] = current + step * (i + 1)
+//
+// up to the target, then the target, which vectorises since every value is
+// independent of the others.
+
+// One block of a smoothed parameter
+struct SmoothedBlock {
+    const float* ramp = nullptr;      // per-sample values, or null when constant
+    float value = 0.0f;               // the constant, or the last ramp value
+
+    bool isRamping() const { return ramp != nullptr; }
+
+    // Calls kernel with an accessor (int sample) -> float, instantiated once
+    // for a ramp and once for a constant
+    template <typename Kernel>
+    void dispatch(Kernel&& kernel) const {
+        if (ramp != nullptr)
+            kernel([values = ramp](int i) { return values[i]; });
+        else
+            kernel([constant = value](int) { return constant; });
+    }
+
+    // Calls kernel with the ramp pointer or the constant, for kernels that
+    // have an overload for each
+    template <typename Kernel>
+    void visit(Kernel&& kernel) const {
+        if (ramp != nullptr)
+            kernel(ramp);
+        else
+            kernel(value);
+    }
+};
+
+class BlockSmoother {
+public:
+    explicit BlockSmoother(float initialValue = 0.0f)
+        : current(initialValue), target(initialValue) {
+    }
+
+    void reset(double sampleRate, double rampSeconds) {
+        rampSamples = static_cast<int>(std::floor(rampSeconds * sampleRate));
+        setCurrentAndTargetValue(target);
+    }
+
+    void setCurrentAndTargetValue(float newValue) {
+        current = target = newValue;
+        countdown = 0;
+    }
+
+    void setTargetValue(float newValue) {
+        if (newValue == target)
+            return;
+
+        if (rampSamples <= 0) {
+            setCurrentAndTargetValue(newValue);
+            return;
+        }
+
+        target = newValue;
+        countdown = rampSamples;
+        step = (target - current) / static_cast<float>(countdown);
+    }
+
+    float getCurrentValue() const { return current; }
+    float getTargetValue() const { return target; }
+    bool isSmoothing() const { return countdown > 0; }
+
+    float getNextValue() {
+        if (countdown == 0)
+            return current;
+
+        current = --countdown == 0 ? target : current + step;
+        return current;
+    }
+
+    // Advances numSamples. While a ramp is running its values are written to
+    // ramp; otherwise nothing is written and the block is a constant.
+    SmoothedBlock renderBlock(float* ramp, int numSamples) {
+        if (countdown == 0 || numSamples <= 0)
+            return { nullptr, current };
+
+        auto rampLength = juce::jmin(countdown, numSamples);
+        auto start = current;
+
+        for (int i = 0; i < rampLength; ++i)
+            ramp[i] = start + step * static_cast<float>(i + 1);
+
+        countdown -= rampLength;
+        if (countdown == 0) {
+            current = target;
+            ramp[rampLength - 1] = target;
+            std::fill(ramp + rampLength, ramp + numSamples, target);
+        }
+        else {
+            current = ramp[rampLength - 1];
+        }
+
+        return { ramp, current };
+    }
+
+private:
+    float current = 0.0f;
+    float target = 0.0f;
+    float step = 0.0f;
+    int countdown = 0;
+    int rampSamples = 0;
+};
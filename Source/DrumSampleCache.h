@@ -0,0 +1,146 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "../Common/FastRandom.h"
+#include "../Common/PhaseAccumulator.h"
+
+// ============================================================================
+// PRE-RENDERED DRUM ONE-SHOTS
+// ============================================================================
+//
+// The drum envelopes and tones are functions of the oscillator's envelope
+// phase, which runs 0..1 over one cycle, so they are rendered once against
+// that phase and replayed at any carrier frequency or sample rate with
+// linear interpolation. The noise is not: stretched over a cycle it would be
+// low-passed and imaged at slow carriers. It comes from a few takes of unit
+// white noise shared by every drum, read one value per output sample since
+// the hit, and is scaled by the drum's noise envelope. Tables stop where the
+// amplitude envelope falls below -90 dB; playback past that point is silence
+// and costs nothing.
+
+class DrumSampleCache {
+public:
+    enum class Drum {
+        Kick = 0,
+        Snare,
+        HatClosed,
+        HatOpen,
+        NumDrums
+    };
+
+    static constexpr int tableBits = 13;
+    static constexpr int tableSize = 1 << tableBits;    // points per envelope cycle
+    static constexpr int numNoiseVariations = 4;
+    static constexpr int noiseBits = 16;
+    static constexpr int noiseLength = 1 << noiseBits;  // samples per take; longer hits wrap
+    static constexpr float silenceThreshold = 3.1623e-5f;  // -90 dB
+
+    struct Voice {
+        std::vector<float> tone;            // empty if none
+        std::vector<float> noiseEnvelope;   // empty if none
+        int activeLength = 0;               // table points above -90 dB
+    };
+
+    static std::shared_ptr<const DrumSampleCache> getShared() {
+        static std::mutex creationLock;
+        static std::weak_ptr<const DrumSampleCache> sharedCache;
+
+        const std::lock_guard<std::mutex> lock(creationLock);
+        auto cache = sharedCache.lock();
+        if (cache == nullptr) {
+            cache = std::make_shared<const DrumSampleCache>();
+            sharedCache = cache;
+        }
+        return cache;
+    }
+
+    DrumSampleCache() {
+        FastRandom random(0xd5a1u);  // fixed seed: identical hits in every session
+
+        for (auto& take : noiseTakes) {
+            take.resize(static_cast<size_t>(noiseLength));
+            for (auto& value : take)
+                value = random.nextFloat();
+        }
+
+        // Same envelopes and mix as the original per-sample generators
+        render(Drum::Kick, 8.0f, 1.0f, 0.0f, [](float e) {
+            float pitchEnv = std::exp(-e * 15.0f);
+            float kickFreq = 55.0f + 200.0f * pitchEnv;
+            return std::sin(kickFreq * e * juce::MathConstants<float>::twoPi);
+        });
+
+        render(Drum::Snare, 12.0f, 0.3f, 0.7f, [](float e) {
+            return std::sin(200.0f * e * juce::MathConstants<float>::twoPi);
+        });
+
+        auto noTone = [](float) { return 0.0f; };
+        render(Drum::HatClosed, 25.0f, 0.0f, 0.5f, noTone);
+        render(Drum::HatOpen, 8.0f, 0.0f, 0.4f, noTone);
+    }
+
+    const Voice& getVoice(Drum drum) const {
+        return voices[static_cast<size_t>(drum)];
+    }
+
+    // envelopePhase is the oscillator phase, which restarts at every hit;
+    // samplesSinceHit counts output samples from the same point, and
+    // variation picks the noise take.
+    float read(const Voice& voice, Phase::Type envelopePhase, int samplesSinceHit, int variation) const {
+        auto index = Phase::index<tableBits>(envelopePhase);
+
+        if (index >= voice.activeLength)
+            return 0.0f;
+
+        auto frac = Phase::fraction<tableBits>(envelopePhase);
+        float sample = 0.0f;
+
+        if (!voice.tone.empty())
+            sample = interpolate(voice.tone, index, frac);
+
+        if (!voice.noiseEnvelope.empty()) {
+            auto& take = noiseTakes[static_cast<size_t>(variation)];
+            sample += take[static_cast<size_t>(samplesSinceHit & (noiseLength - 1))]
+                * interpolate(voice.noiseEnvelope, index, frac);
+        }
+
+        return sample;
+    }
+
+private:
+    std::array<Voice, static_cast<size_t>(Drum::NumDrums)> voices;
+    std::array<std::vector<float>, numNoiseVariations> noiseTakes;
+
+    static float interpolate(const std::vector<float>& table, int index, float frac) {
+        auto a = table[static_cast<size_t>(index)];
+        return a + frac * (table[static_cast<size_t>(index) + 1] - a);
+    }
+
+    template <typename ToneFunction>
+    void render(Drum drum, float decay, float toneGain, float noiseGain, ToneFunction tone) {
+        auto& voice = voices[static_cast<size_t>(drum)];
+
+        // exp(-decay * e) < threshold  <=>  e > -ln(threshold) / decay
+        auto silentPhase = -std::log(silenceThreshold) / decay;
+        voice.activeLength = juce::jmin(tableSize, static_cast<int>(std::ceil(silentPhase * tableSize)));
+
+        if (toneGain > 0.0f) {
+            voice.tone.resize(static_cast<size_t>(voice.activeLength) + 1);
+            for (int i = 0; i <= voice.activeLength; ++i) {
+                auto e = static_cast<float>(i) / static_cast<float>(tableSize);
+                voice.tone[static_cast<size_t>(i)] = tone(e) * std::exp(-e * decay) * toneGain;
+            }
+        }
+
+        if (noiseGain > 0.0f) {
+            voice.noiseEnvelope.resize(static_cast<size_t>(voice.activeLength) + 1);
+            for (int i = 0; i <= voice.activeLength; ++i) {
+                auto e = static_cast<float>(i) / static_cast<float>(tableSize);
+                voice.noiseEnvelope[static_cast<size_t>(i)] = std::exp(-e * decay) * noiseGain;
+            }
+        }
+    }
+};
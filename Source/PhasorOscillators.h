@@ -0,0 +1,261 @@
+#pragma once
+#include <JuceHeader.h>
+#include <cmath>
+
+// ============================================================================
+// QUADRATURE (ROTATING PHASOR) SINE OSCILLATOR
+// ============================================================================
+//
+// Produces sin(2 pi phase) by rotating a unit complex number by the phase
+// increment every sample, so no trig is evaluated in the steady state. State
+// is kept in double precision and its magnitude is renormalised periodically
+// to stop amplitude creep over long sessions.
+//
+// When a per-sample increment array is supplied (e.g. a smoothing frequency
+// ramp), each sample's rotation is derived from that sample's increment with
+// a short Taylor series, so retuning is sample-accurate and matches the phase
+// a plain accumulator would reach.
+
+class QuadratureOscillator {
+public:
+    static constexpr int renormaliseInterval = 32;
+
+    void reset(double phase = 0.0) {
+        auto angle = juce::MathConstants<double>::twoPi * phase;
+        real = std::cos(angle);
+        imag = std::sin(angle);
+        samplesSinceRenormalise = 0;
+    }
+
+    void setIncrement(double phaseIncrement) {
+        if (phaseIncrement == increment)
+            return;
+
+        increment = phaseIncrement;
+        auto angle = juce::MathConstants<double>::twoPi * phaseIncrement;
+        rotationReal = std::cos(angle);
+        rotationImag = std::sin(angle);
+    }
+
+    // Current phase in cycles, [0, 1)
+    double getPhase() const {
+        auto phase = std::atan2(imag, real) / juce::MathConstants<double>::twoPi;
+        return phase < 0.0 ? phase + 1.0 : phase;
+    }
+
+    double getSine() const { return imag; }
+    double getCosine() const { return real; }
+
+    // Rotates by an arbitrary per-sample increment (sample-accurate retuning)
+    void advance(double phaseIncrement) {
+        double cosine, sine;
+        rotationForIncrement(phaseIncrement, cosine, sine);
+        rotate(cosine, sine);
+    }
+
+    // Rotates by the increment from setIncrement()
+    void advance() {
+        rotate(rotationReal, rotationImag);
+    }
+
+    float getNextSample() {
+        auto sample = static_cast<float>(imag);
+        advance();
+        return sample;
+    }
+
+    // phaseIncrements may be null, in which case the increment from
+    // setIncrement() is used for the whole block.
+    void processBlock(float* output, const float* phaseIncrements, int numSamples) {
+        if (phaseIncrements == nullptr) {
+            for (int i = 0; i < numSamples; ++i)
+                output[i] = getNextSample();
+            return;
+        }
+
+        for (int i = 0; i < numSamples; ++i) {
+            output[i] = static_cast<float>(imag);
+            advance(static_cast<double>(phaseIncrements[i]));
+        }
+
+        if (numSamples > 0)
+            setIncrement(static_cast<double>(phaseIncrements[numSamples - 1]));
+    }
+
+    // cos / sin of 2 pi * increment. Uses a Taylor series for the small angles
+    // of audible-rate tones (error below 1e-12 rad for |angle| <= 0.5) and
+    // falls back to the library for anything larger.
+    static void rotationForIncrement(double phaseIncrement, double& cosine, double& sine) {
+        auto x = juce::MathConstants<double>::twoPi * phaseIncrement;
+
+        if (std::abs(x) > 0.5) {
+            cosine = std::cos(x);
+            sine = std::sin(x);
+            return;
+        }
+
+        auto x2 = x * x;
+        cosine = 1.0 - x2 * (1.0 / 2.0 - x2 * (1.0 / 24.0 - x2 * (1.0 / 720.0 - x2 * (1.0 / 40320.0 - x2 * (1.0 / 3628800.0)))));
+        sine = x * (1.0 - x2 * (1.0 / 6.0 - x2 * (1.0 / 120.0 - x2 * (1.0 / 5040.0 - x2 * (1.0 / 362880.0 - x2 * (1.0 / 39916800.0))))));
+    }
+
+private:
+    double real = 1.0;
+    double imag = 0.0;
+    double increment = 0.0;
+    double rotationReal = 1.0;
+    double rotationImag = 0.0;
+    int samplesSinceRenormalise = 0;
+
+    void rotate(double cosine, double sine) {
+        auto newReal = real * cosine - imag * sine;
+        imag = real * sine + imag * cosine;
+        real = newReal;
+
+        if (++samplesSinceRenormalise >= renormaliseInterval) {
+            // First-order correction towards |z| = 1; exact enough because the
+            // drift over one interval is at rounding level.
+            auto gain = 1.5 - 0.5 * (real * real + imag * imag);
+            real *= gain;
+            imag *= gain;
+            samplesSinceRenormalise = 0;
+        }
+    }
+};
+
+// ============================================================================
+// STEREO SUM / DIFFERENCE PHASOR PAIR
+// ============================================================================
+//
+// Generates both ears of a binaural pair from one carrier phasor C and one
+// offset phasor D using the angle-sum identities:
+//
+//     left  = Im(C * D)       = sin(c + d)
+//     right = Im(C * conj(D)) = sin(c - d)
+//
+// Two complex rotations per stereo frame replace two independent oscillators,
+// and the ears stay phase-locked to the shared carrier by construction.
+//
+// The offset can either advance by an increment (beat / 2 for binaural
+// pairs) or follow an absolute phase (Bilateral Sync's phase split); in the
+// latter case each sample rotates D by the change in offset. The carrier
+// phasor doubles as the plugin's shared carrier phase.
+//
+// Either increment array may be null for a block where that rate is
+// constant; the increment from setIncrements() is used instead, which turns
+// the per-sample rotation into a fixed one.
+
+class StereoPhasorPair {
+public:
+    void reset(double carrierPhase = 0.0, double offsetPhase = 0.0) {
+        carrier.reset(carrierPhase);
+        offset.reset(offsetPhase);
+        currentOffset = offsetPhase;
+    }
+
+    // Rates used for blocks whose increment array is null
+    void setIncrements(double carrierIncrement, double offsetPhaseIncrement) {
+        carrier.setIncrement(carrierIncrement);
+        offset.setIncrement(offsetPhaseIncrement);
+        offsetIncrement = offsetPhaseIncrement;
+    }
+
+    // Offset advances by offsetIncrements[i] cycles per sample.
+    void processBlock(float* left, float* right, const float* carrierIncrements,
+        const float* offsetIncrements, int numSamples) {
+        if (carrierIncrements != nullptr) {
+            if (offsetIncrements != nullptr)
+                renderIncrements<true, true>(left, right, carrierIncrements, offsetIncrements, numSamples);
+            else
+                renderIncrements<true, false>(left, right, carrierIncrements, nullptr, numSamples);
+        }
+        else {
+            if (offsetIncrements != nullptr)
+                renderIncrements<false, true>(left, right, nullptr, offsetIncrements, numSamples);
+            else
+                renderIncrements<false, false>(left, right, nullptr, nullptr, numSamples);
+        }
+
+        currentOffset -= std::floor(currentOffset);
+    }
+
+    // Offset is set to offsetPhases[i] cycles at each sample.
+    void processBlockWithOffsets(float* left, float* right, const float* carrierIncrements,
+        const float* offsetPhases, int numSamples) {
+        if (carrierIncrements != nullptr)
+            renderOffsets<true>(left, right, carrierIncrements, offsetPhases, numSamples);
+        else
+            renderOffsets<false>(left, right, nullptr, offsetPhases, numSamples);
+    }
+
+    // Keeps the shared carrier running while another engine renders the tone.
+    void advanceCarrier(const float* carrierIncrements, int numSamples) {
+        if (carrierIncrements == nullptr) {
+            for (int i = 0; i < numSamples; ++i)
+                carrier.advance();
+            return;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+            carrier.advance(static_cast<double>(carrierIncrements[i]));
+    }
+
+    double getCarrierPhase() const {
+        return carrier.getPhase();
+    }
+
+private:
+    QuadratureOscillator carrier;
+    QuadratureOscillator offset;
+    double currentOffset = 0.0;
+    double offsetIncrement = 0.0;
+
+    template <bool PerSampleCarrier, bool PerSampleOffset>
+    void renderIncrements(float* left, float* right, const float* carrierIncrements,
+        const float* offsetIncrements, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            renderFrame(left[i], right[i]);
+
+            if constexpr (PerSampleCarrier)
+                carrier.advance(static_cast<double>(carrierIncrements[i]));
+            else
+                carrier.advance();
+
+            if constexpr (PerSampleOffset) {
+                offset.advance(static_cast<double>(offsetIncrements[i]));
+                currentOffset += static_cast<double>(offsetIncrements[i]);
+            }
+            else {
+                offset.advance();
+            }
+        }
+
+        if constexpr (!PerSampleOffset)
+            currentOffset += offsetIncrement * numSamples;
+    }
+
+    template <bool PerSampleCarrier>
+    void renderOffsets(float* left, float* right, const float* carrierIncrements,
+        const float* offsetPhases, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            auto delta = static_cast<double>(offsetPhases[i]) - currentOffset;
+            delta -= std::round(delta);
+            offset.advance(delta);
+            currentOffset = static_cast<double>(offsetPhases[i]);
+
+            renderFrame(left[i], right[i]);
+
+            if constexpr (PerSampleCarrier)
+                carrier.advance(static_cast<double>(carrierIncrements[i]));
+            else
+                carrier.advance();
+        }
+    }
+
+    void renderFrame(float& left, float& right) const {
+        auto sinCosD = carrier.getSine() * offset.getCosine();
+        auto cosSinD = carrier.getCosine() * offset.getSine();
+        left = static_cast<float>(sinCosD + cosSinD);
+        right = static_cast<float>(sinCosD - cosSinD);
+    }
+};
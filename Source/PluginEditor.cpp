@@ -91,7 +91,8 @@ BrainwaveEntrainmentAudioProcessorEditor::BrainwaveEntrainmentAudioProcessorEdit
 
     waveformSelector.addItemList(juce::StringArray{
         "Sine", "Triangle", "Sawtooth", "Square", "Pulse",
-        "Noise", "Kick", "Snare", "Hat Closed", "Hat Open" }, 1);
+        "Noise", "Kick", "Snare", "Hat Closed", "Hat Open",
+        "Triangle (BLEP)", "Sawtooth (BLEP)", "Square (BLEP)", "Pulse (BLEP)" }, 1);
     addAndMakeVisible(waveformSelector);
     waveformAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
         audioProcessor.getValueTreeState(), "waveform", waveformSelector);
@@ -204,6 +205,8 @@ BrainwaveEntrainmentAudioProcessorEditor::BrainwaveEntrainmentAudioProcessorEdit
     rmsLabel.setJustificationType(juce::Justification::centredRight);
     addAndMakeVisible(rmsLabel);
 
+    // Frames queued while no editor was open are stale
+    audioProcessor.getMeterRing().skipAll();
     startTimerHz(30);
 }
 
@@ -311,6 +314,24 @@ void BrainwaveEntrainmentAudioProcessorEditor::paint(juce::Graphics& g) {
 
         g.setColour(juce::Colour(0xff16c79a).withAlpha(0.7f));
         g.strokePath(wavePath, juce::PathStrokeType(2.0f));
+
+        // Entrainment level history along the bottom, newest at the right
+        juce::Path historyPath;
+        auto historyStep = visArea.getWidth() / static_cast<float>(levelHistorySize - 1);
+
+        for (int i = 0; i < levelHistorySize; ++i) {
+            auto level = levelHistory[static_cast<size_t>((historyPosition + i) % levelHistorySize)];
+            auto x = visArea.getX() + historyStep * static_cast<float>(i);
+            auto y = visArea.getBottom() - juce::jmin(1.0f, level * 2.0f) * visArea.getHeight();
+
+            if (i == 0)
+                historyPath.startNewSubPath(x, y);
+            else
+                historyPath.lineTo(x, y);
+        }
+
+        g.setColour(juce::Colour(0xff00d9ff).withAlpha(0.5f));
+        g.strokePath(historyPath, juce::PathStrokeType(1.0f));
     }
 }
 
@@ -323,14 +344,41 @@ void BrainwaveEntrainmentAudioProcessorEditor::timerCallback() {
     float beatHz = audioProcessor.getCurrentBeatFrequency();
     beatLabel.setText("Beat: " + juce::String(beatHz, 2) + " Hz", juce::dontSendNotification);
 
-    // Update RMS monitoring
-    float leftRMS = audioProcessor.getLeftRMSLevel();
-    float rightRMS = audioProcessor.getRightRMSLevel();
-    float avgRMS = (leftRMS + rightRMS) * 0.5f;
+    // Drain every block since the last tick: RMS over all of them, the
+    // highest peak, and the entrainment level for the history trace
+    double outputEnergy = 0.0;
+    double entrainmentEnergy = 0.0;
+    float peak = 0.0f;
+    int numSamples = 0;
+
+    audioProcessor.getMeterRing().drain([&](const MeterFrame& frame) {
+        auto weight = static_cast<double>(frame.numSamples);
+        outputEnergy += 0.5 * (frame.rmsLeft * frame.rmsLeft + frame.rmsRight * frame.rmsRight) * weight;
+        entrainmentEnergy += frame.entrainment * frame.entrainment * weight;
+        peak = juce::jmax(peak, frame.peakLeft, frame.peakRight);
+        numSamples += frame.numSamples;
+    });
+
+    auto entrainmentRms = 0.0f;
+    if (numSamples > 0) {
+        outputRms = static_cast<float>(std::sqrt(outputEnergy / numSamples));
+        entrainmentRms = static_cast<float>(std::sqrt(entrainmentEnergy / numSamples));
+    }
+    else {
+        outputRms = 0.0f;
+    }
 
-    if (avgRMS > 0.0001f) {
-        float splApprox = 20.0f * std::log10(avgRMS) + 94.0f;
-        rmsLabel.setText("SPL: ~" + juce::String(splApprox, 1) + " dB", juce::dontSendNotification);
+    // Peak hold falls about 20 dB per second
+    peakHold = juce::jmax(peak, peakHold * 0.93f);
+
+    levelHistory[static_cast<size_t>(historyPosition)] = entrainmentRms;
+    historyPosition = (historyPosition + 1) % levelHistorySize;
+
+    // Update RMS monitoring
+    if (outputRms > 0.0001f) {
+        float splApprox = 20.0f * std::log10(outputRms) + 94.0f;
+        rmsLabel.setText("SPL: ~" + juce::String(splApprox, 1) + " dB | Peak: "
+            + juce::String(juce::Decibels::gainToDecibels(peakHold), 1) + " dBFS", juce::dontSendNotification);
     }
     else {
         rmsLabel.setText("SPL: -- dB", juce::dontSendNotification);
@@ -74,5 +74,12 @@ private:
     juce::Label rmsLabel;
     juce::Label beatLabel;
 
+    // Metering, fed from the processor's meter ring once per timer tick
+    static constexpr int levelHistorySize = 90;     // three seconds of ticks
+    float outputRms = 0.0f;                         // over the frames of the last tick
+    float peakHold = 0.0f;                          // decays once the peak has passed
+    std::array<float, levelHistorySize> levelHistory{};   // entrainment level, oldest first
+    int historyPosition = 0;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BrainwaveEntrainmentAudioProcessorEditor)
 };
\ No newline at end of file
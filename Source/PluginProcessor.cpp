@@ -1,6 +1,53 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+#if BRAINWAVE_CHECK_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+
+// Replacement global allocation functions, so ScopedNoAllocations can see
+// every heap allocation (see AllocationCheck.h)
+void* operator new(std::size_t size) {
+    AllocationCheck::noteAllocation();
+
+    if (auto* memory = std::malloc(size > 0 ? size : 1))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+// GCC flags the inlined free() as not matching operator new, not knowing
+// this file replaces both
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+void operator delete[](void* memory) noexcept {
+    operator delete(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    operator delete(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    operator delete(memory);
+}
+#endif
+
 // ============================================================================
 // AUDIO PROCESSOR EDITOR IMPLEMENTATION
 // ============================================================================
@@ -19,36 +66,31 @@ BrainwaveEntrainmentAudioProcessor::BrainwaveEntrainmentAudioProcessor()
         .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
     parameters(*this, nullptr, "Parameters", createParameterLayout()) {
 
-    // Add parameter listeners
-    parameters.addParameterListener("brainwave_frequency", this);
-    parameters.addParameterListener("entrainment_mode", this);
-    parameters.addParameterListener("carrier_frequency", this);
-    parameters.addParameterListener("solfeggio_preset", this);
-    parameters.addParameterListener("beat_offset", this);
-    parameters.addParameterListener("waveform", this);
-    parameters.addParameterListener("wet_mix", this);
-    parameters.addParameterListener("modulation_depth", this);
-    parameters.addParameterListener("hemisync_correlation", this);
-    parameters.addParameterListener("hemisync_drift", this);
-    parameters.addParameterListener("operation_mode", this);
-    parameters.addParameterListener("gate_threshold", this);
-    parameters.addParameterListener("auto_gain_sensitivity", this);
+    // Parameters read every block, so the audio thread never looks them up by name
+    paramPointers.brainwaveFrequency = parameters.getRawParameterValue("brainwave_frequency");
+    paramPointers.beatOffset = parameters.getRawParameterValue("beat_offset");
+    paramPointers.carrierFrequency = parameters.getRawParameterValue("carrier_frequency");
+    paramPointers.solfeggioPreset = parameters.getRawParameterValue("solfeggio_preset");
+    paramPointers.operationMode = parameters.getRawParameterValue("operation_mode");
+    paramPointers.wetMix = parameters.getRawParameterValue("wet_mix");
+    paramPointers.gateThreshold = parameters.getRawParameterValue("gate_threshold");
+    paramPointers.autoGainSensitivity = parameters.getRawParameterValue("auto_gain_sensitivity");
+    paramPointers.noiseAmount = parameters.getRawParameterValue("noise_amount");
+    paramPointers.hemiDrift = parameters.getRawParameterValue("hemisync_drift");
+    paramPointers.hemiCorrelation = parameters.getRawParameterValue("hemisync_correlation");
+    paramPointers.masterGain = parameters.getRawParameterValue("master_gain");
+
+    // Listener-driven settings
+    for (int i = 0; i < numParameterTargets; ++i) {
+        auto* id = getParameterId(static_cast<ParameterTarget>(i));
+        targetValues[static_cast<size_t>(i)] = parameters.getRawParameterValue(id);
+        parameters.addParameterListener(id, this);
+    }
 }
 
 BrainwaveEntrainmentAudioProcessor::~BrainwaveEntrainmentAudioProcessor() {
-    parameters.removeParameterListener("brainwave_frequency", this);
-    parameters.removeParameterListener("entrainment_mode", this);
-    parameters.removeParameterListener("carrier_frequency", this);
-    parameters.removeParameterListener("solfeggio_preset", this);
-    parameters.removeParameterListener("beat_offset", this);
-    parameters.removeParameterListener("waveform", this);
-    parameters.removeParameterListener("wet_mix", this);
-    parameters.removeParameterListener("modulation_depth", this);
-    parameters.removeParameterListener("hemisync_correlation", this);
-    parameters.removeParameterListener("hemisync_drift", this);
-    parameters.removeParameterListener("operation_mode", this);
-    parameters.removeParameterListener("gate_threshold", this);
-    parameters.removeParameterListener("auto_gain_sensitivity", this);
+    for (int i = 0; i < numParameterTargets; ++i)
+        parameters.removeParameterListener(getParameterId(static_cast<ParameterTarget>(i)), this);
 }
 
 // ============================================================================
@@ -58,6 +100,9 @@ BrainwaveEntrainmentAudioProcessor::~BrainwaveEntrainmentAudioProcessor() {
 void BrainwaveEntrainmentAudioProcessor::prepareToPlay(double sr, int samplesPerBlock) {
     sampleRate = sr;
 
+    // Kernels for the widest instruction set this CPU runs (see SimdDispatch.h)
+    simdTier = SimdDispatch::selectTier();
+
     carrierOsc.setSampleRate(sr);
     leftModOsc.setSampleRate(sr);
     rightModOsc.setSampleRate(sr);
@@ -65,29 +110,82 @@ void BrainwaveEntrainmentAudioProcessor::prepareToPlay(double sr, int samplesPer
     // Setup smoothed values
     currentBeatHz.reset(sr, 0.05);
     carrierHz.reset(sr, 0.05);
-    wetMixSmooth.reset(sr, 0.01);
     modulationDepthSmooth.reset(sr, 0.05);
     actualWetMix.reset(sr, 0.05);
-    inputEnvelope.reset(sr, 0.1); // Envelope follower with 100ms smoothing
-
-    // Setup spectral asymmetry filters
-    leftFilter.setLowpass(sr, 2000.0f, 0.707f);
-    rightFilter.setLowpass(sr, 2400.0f, 0.707f);
 
-    // Initialize entrainment buffer
-    entrainmentBuffer.setSize(2, samplesPerBlock);
+    // Input level for the operation modes
+    inputDetector.setMode(LevelDetector::Mode::Rms);
+    inputDetector.setAttackTime(20.0f);
+    inputDetector.setReleaseTime(150.0f);
+    inputDetector.setHoldTime(50.0f);
+    inputDetector.prepare(sr);
+    inputGate.prepare(sr);
+    inputGate.setHysteresis(6.0f);
+    inputGate.setRampTime(10.0f);
+    inputGate.reset();
 
-    updateFrequencies();
+    // Setup spectral asymmetry filters
+    spectralFilters.setLowpass(0, sr, 2000.0f, 0.707f);
+    spectralFilters.setLowpass(1, sr, 2400.0f, 0.707f);
+
+    noiseGen.prepare(sr);
+
+    // Gate curves are cubic between control points; drift is slow enough for lines
+    gateLfo.setSampleRate(sr);
+    gateLfo.setControlInterval(32);
+    isochronicPulse.setSampleRate(sr);
+    driftLfo.setSampleRate(sr);
+    driftLfo.setControlInterval(64);
+    driftLfo.setInterpolation(ControlRateLfo<MathTier::driftLfo>::Interpolation::Linear);
+
+    // Scratch for one processing chunk, whatever block size the host sends
+    juce::ignoreUnused(samplesPerBlock);
+    entrainmentBuffer.setSize(2, processingChunkSize);
+    controlBuffer.setSize(NumControlChannels, processingChunkSize);
+
+    // Nothing is rendering yet: take every listener-driven setting as it is now
+    commandQueue.drain([](const ParameterCommand&) {});
+    commandQueue.checkAndClearOverflow();
+    applyAllParameters();
+
+    // Start at the current frequencies rather than gliding to them
+    auto snapshot = takeSnapshot();
+    currentBeatHz.setCurrentAndTargetValue(snapshot.beatHz);
+    carrierHz.setCurrentAndTargetValue(snapshot.carrierHz);
+    modulationDepthSmooth.setCurrentAndTargetValue(modulationDepthSmooth.getTargetValue());
 }
 
 void BrainwaveEntrainmentAudioProcessor::releaseResources() {
     entrainmentBuffer.setSize(0, 0);
+    controlBuffer.setSize(0, 0);
 }
 
 void BrainwaveEntrainmentAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     juce::MidiBuffer& midiMessages) {
     juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+void BrainwaveEntrainmentAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer,
+    juce::MidiBuffer& midiMessages) {
+    juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+// Shared by both precisions: the entrainment signal is always rendered in
+// float, and only the host's audio is carried as SampleType
+template <typename SampleType>
+void BrainwaveEntrainmentAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer) {
     juce::ScopedNoDenormals noDenormals;
+    ScopedNoAllocations noAllocations;
+
+    // Settings changed since the last block all land before it is rendered,
+    // so a preset change applies as a whole
+    commandQueue.drain([this](const ParameterCommand& command) { applyCommand(command); });
+    if (commandQueue.checkAndClearOverflow())
+        applyAllParameters();
+
+    auto snapshot = takeSnapshot();
 
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -104,308 +202,547 @@ void BrainwaveEntrainmentAudioProcessor::processBlock(juce::AudioBuffer<float>&
         }
     }
 
-    // Generate entrainment signal
-    entrainmentBuffer.clear();
-    applyEntrainmentToInput(buffer);
+    // Generate entrainment signal in fixed chunks, each a view onto the
+    // host buffer, so the scratch buffers never need more than one chunk
+    auto numChannels = juce::jmin(buffer.getNumChannels(), 2);
+    SampleType* chunkChannels[2] = {};
+    blockMeters.reset();
+
+    for (int start = 0; start < buffer.getNumSamples(); start += processingChunkSize) {
+        auto chunkSize = juce::jmin(processingChunkSize, buffer.getNumSamples() - start);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            chunkChannels[channel] = buffer.getWritePointer(channel, start);
+
+        juce::AudioBuffer<SampleType> chunk(chunkChannels, numChannels, chunkSize);
+        entrainmentBuffer.clear();
+        applyEntrainmentToInput(chunk, snapshot);
+    }
+
+    meterRing.push(blockMeters.getFrame());
 
     // Apply master gain
-    auto masterGain = parameters.getRawParameterValue("master_gain")->load();
-    auto gainLinear = juce::Decibels::decibelsToGain(masterGain);
+    auto gainLinear = juce::Decibels::decibelsToGain(static_cast<SampleType>(snapshot.masterGainDb));
     buffer.applyGain(gainLinear);
 }
 
-void BrainwaveEntrainmentAudioProcessor::applyEntrainmentToInput(juce::AudioBuffer<float>& buffer) {
+template <typename SampleType>
+void BrainwaveEntrainmentAudioProcessor::applyEntrainmentToInput(juce::AudioBuffer<SampleType>& buffer, const ParamSnapshot& snapshot) {
     auto numSamples = buffer.getNumSamples();
     auto numChannels = juce::jmin(buffer.getNumChannels(), 2);
 
-    // Step 1: Calculate input envelope (RMS) for the current block
-    float inputLevel = 0.0f;
-    for (int channel = 0; channel < numChannels; ++channel) {
-        auto* inputData = buffer.getReadPointer(channel);
-        float channelLevel = 0.0f;
-        for (int sample = 0; sample < numSamples; ++sample) {
-            channelLevel += inputData[sample] * inputData[sample];
+    // Step 1: Follow the input level and derive a per-sample wet gain for
+    // the operation mode
+    auto* envelopeRamp = controlBuffer.getWritePointer(InputEnvelope);
+    auto* modeGainRamp = controlBuffer.getWritePointer(ModeGain);
+
+    if (snapshot.operationMode == OperationMode::AlwaysOn) {
+        // Nothing reads the per-sample envelope, only the meter, so step
+        // the detector once over the block's mean level
+        float meanSquare = 0.0f;
+        for (int channel = 0; channel < numChannels; ++channel) {
+            auto rms = static_cast<float>(buffer.getRMSLevel(channel, 0, numSamples));
+            meanSquare += rms * rms;
         }
-        inputLevel += std::sqrt(channelLevel / numSamples);
-    }
-    inputLevel /= numChannels;
 
-    // Update envelope follower
-    inputEnvelope.setTargetValue(inputLevel);
-
-    // Get current smoothed envelope value
-    float currentEnvelope = 0.0f;
-    for (int i = 0; i < numSamples; ++i) {
-        currentEnvelope = inputEnvelope.getNextValue();
+        inputDetector.advance(std::sqrt(meanSquare / static_cast<float>(juce::jmax(1, numChannels))), numSamples);
+    }
+    else if constexpr (std::is_same_v<SampleType, float>) {
+        inputDetector.processBlock(buffer.getArrayOfReadPointers(), numChannels, numSamples, envelopeRamp);
     }
+    else {
+        // The detector only needs float resolution
+        const float* detectorInput[2] = { controlBuffer.getWritePointer(InputLeft), controlBuffer.getWritePointer(InputRight) };
 
-    // Convert to dB for gate threshold
-    float inputLevelDB = juce::Decibels::gainToDecibels(currentEnvelope, -100.0f);
+        for (int channel = 0; channel < numChannels; ++channel) {
+            auto* input = buffer.getReadPointer(channel);
+            auto* converted = controlBuffer.getWritePointer(channel == 0 ? InputLeft : InputRight);
 
-    // Get user settings
-    float userWet = parameters.getRawParameterValue("wet_mix")->load();
-    int opMode = static_cast<int>(parameters.getRawParameterValue("operation_mode")->load());
-    float gateThreshold = parameters.getRawParameterValue("gate_threshold")->load();
-    float autoSensitivity = parameters.getRawParameterValue("auto_gain_sensitivity")->load();
+            for (int sample = 0; sample < numSamples; ++sample)
+                converted[sample] = static_cast<float>(input[sample]);
+        }
 
-    // Apply operation mode
-    float targetWet = userWet;
+        inputDetector.processBlock(detectorInput, numChannels, numSamples, envelopeRamp);
+    }
 
-    switch (opMode) {
-    case 0: // Always On
-        targetWet = userWet;
+    // Apply operation mode
+    switch (snapshot.operationMode) {
+    case OperationMode::GateTrigger: // opens above the threshold, closes 6 dB below it
+        inputGate.setThreshold(snapshot.gateThresholdDb);
+        inputGate.process(envelopeRamp, modeGainRamp, numSamples);
         break;
 
-    case 1: // Gate Trigger
-        targetWet = (inputLevelDB > gateThreshold) ? userWet : 0.0f;
+    case OperationMode::AutoGain:
+        // Scale wet mix based on input level (inverse relationship)
+        for (int sample = 0; sample < numSamples; ++sample)
+            modeGainRamp[sample] = juce::jlimit(0.0f, 1.0f, 1.0f - envelopeRamp[sample] * snapshot.autoGainSensitivity);
         break;
 
-    case 2: // Auto Gain
-        // Scale wet mix based on input level (inverse relationship)
-        float scaledWet = userWet * (1.0f - (currentEnvelope * autoSensitivity));
-        targetWet = juce::jlimit(0.0f, userWet, scaledWet);
+    default: // Always On
+        std::fill(modeGainRamp, modeGainRamp + numSamples, 1.0f);
         break;
     }
 
-    actualWetMix.setTargetValue(targetWet);
+    actualWetMix.setTargetValue(snapshot.wetMix);
 
     // Step 2: Generate entrainment signal
-    auto noiseAmount = parameters.getRawParameterValue("noise_amount")->load();
-    auto hemiDrift = parameters.getRawParameterValue("hemisync_drift")->load();
-    correlationAmount = parameters.getRawParameterValue("hemisync_correlation")->load();
-
-    for (int sample = 0; sample < numSamples; ++sample) {
-        float beatHz = currentBeatHz.getNextValue();
-        float carrier = carrierHz.getNextValue();
-        float modDepthSmooth = modulationDepthSmooth.getNextValue();
-
-        float time = static_cast<float>(sample) / static_cast<float>(sampleRate);
+    auto noiseAmount = snapshot.noiseAmount;
+    auto hemiDrift = snapshot.hemiDrift;
+    correlationAmount = snapshot.hemiCorrelation;
+
+    currentBeatHz.setTargetValue(snapshot.beatHz);
+    carrierHz.setTargetValue(snapshot.carrierHz);
+
+    auto* carrierIncrements = controlBuffer.getWritePointer(CarrierIncrement);
+    const float invSampleRate = 1.0f / static_cast<float>(sampleRate);
+
+    // Smoothed parameters: a constant for the block unless a ramp is running,
+    // so the kernels can skip the per-sample arrays for constants
+    EntrainmentBlock block;
+    block.beatHz = currentBeatHz.renderBlock(controlBuffer.getWritePointer(BeatHzRamp), numSamples);
+    block.carrier = carrierHz.renderBlock(controlBuffer.getWritePointer(CarrierHzRamp), numSamples);
+    block.depth = modulationDepthSmooth.renderBlock(controlBuffer.getWritePointer(DepthRamp), numSamples);
+    block.noiseAmount = noiseAmount;
+    block.hemiDrift = hemiDrift;
+    block.invSampleRate = invSampleRate;
+    block.numSamples = numSamples;
+
+    // Null increments select the oscillators' fixed-rate paths
+    if (block.carrier.isRamping()) {
+        for (int sample = 0; sample < numSamples; ++sample)
+            carrierIncrements[sample] = block.carrier.ramp[sample] * invSampleRate;
+        block.carrierRate = carrierIncrements;
+    }
+    else {
+        carrierOsc.setFrequency(block.carrier.value);
+    }
 
-        float leftEntrainment = 0.0f;
-        float rightEntrainment = 0.0f;
+    stereoPhasors.setIncrements(block.carrier.value * invSampleRate, block.beatHz.value * 0.5f * invSampleRate);
 
-        // ====================================================================
-        // BILATERAL SYNC MODE
-        // ====================================================================
-        if (currentMode == EntrainmentMode::BilateralSync) {
-            sharedPhase += carrier / static_cast<float>(sampleRate);
-            if (sharedPhase >= 1.0f) sharedPhase -= 1.0f;
+    auto flags = (noiseAmount > 0.01f ? NoiseOn : 0) | (hemiDrift > 0.0f ? DriftOn : 0);
+    auto kernel = entrainmentKernels[static_cast<size_t>(simdTier)][static_cast<size_t>(currentMode)][static_cast<size_t>(flags)];
+    (this->*kernel)(block);
 
-            driftPhase += (0.02f * hemiDrift) / static_cast<float>(sampleRate);
-            if (driftPhase >= 1.0f) driftPhase -= 1.0f;
+    // Step 3: Mix input with entrainment signal using actual wet mix; the
+    // same wet curve applies to both channels
+    auto wetMix = actualWetMix.renderBlock(controlBuffer.getWritePointer(WetRamp), numSamples);
 
-            float driftModulation = std::sin(driftPhase * juce::MathConstants<float>::twoPi) * 0.1f;
+    switch (simdTier) {
+#if BRAINWAVE_SIMD_DISPATCH
+    case SimdTier::Avx512: mixEntrainmentAvx512(buffer, wetMix, modeGainRamp); break;
+    case SimdTier::Avx2:   mixEntrainmentAvx2(buffer, wetMix, modeGainRamp); break;
+#endif
+    default:               mixEntrainment(buffer, wetMix, modeGainRamp); break;
+    }
 
-            float leftPhase = sharedPhase + (beatHz * 0.5f / carrier) + driftModulation;
-            float rightPhase = sharedPhase - (beatHz * 0.5f / carrier) - driftModulation;
+    // Levels for the editor's meters, pushed once the whole block is done
+    MeterFrame meters;
+    meters.peakLeft = static_cast<float>(buffer.getMagnitude(0, 0, numSamples));
+    meters.peakRight = static_cast<float>(buffer.getMagnitude(numChannels - 1, 0, numSamples));
+    meters.rmsLeft = static_cast<float>(buffer.getRMSLevel(0, 0, numSamples));
+    meters.rmsRight = static_cast<float>(buffer.getRMSLevel(numChannels - 1, 0, numSamples));
+    meters.entrainment = 0.5f * (entrainmentBuffer.getRMSLevel(0, 0, numSamples)
+        + entrainmentBuffer.getRMSLevel(1, 0, numSamples));
+    meters.envelope = inputDetector.getEnvelope();
+    meters.numSamples = numSamples;
+    blockMeters.add(meters);
+}
 
-            float leftCarrier = std::sin(leftPhase * juce::MathConstants<float>::twoPi);
-            float rightCarrier = std::sin(rightPhase * juce::MathConstants<float>::twoPi);
+template <typename SampleType>
+void BrainwaveEntrainmentAudioProcessor::mixEntrainment(juce::AudioBuffer<SampleType>& buffer, const SmoothedBlock& wetMix, const float* modeGain) {
+    auto numSamples = buffer.getNumSamples();
+    auto numChannels = juce::jmin(buffer.getNumChannels(), 2);
 
-            float sharedNoise = noiseGen.generatePink();
-            float independentNoise = noiseGen.generatePink();
+    for (int channel = 0; channel < numChannels; ++channel) {
+        auto* inputData = buffer.getWritePointer(channel);
+        auto* entrainmentData = entrainmentBuffer.getReadPointer(channel);
 
-            float leftNoise = sharedNoise * correlationAmount +
-                independentNoise * (1.0f - correlationAmount);
-            float rightNoise = sharedNoise * correlationAmount +
-                noiseGen.generatePink() * (1.0f - correlationAmount);
+        wetMix.dispatch([&](auto wetAt) {
+            for (int sample = 0; sample < numSamples; ++sample) {
+                auto wet = static_cast<SampleType>(wetAt(sample) * modeGain[sample]);
+                auto dry = SampleType(1) - wet;
 
-            leftEntrainment = leftCarrier * (1.0f - noiseAmount) + leftNoise * noiseAmount;
-            rightEntrainment = rightCarrier * (1.0f - noiseAmount) + rightNoise * noiseAmount;
+                inputData[sample] = (inputData[sample] * dry) + (static_cast<SampleType>(entrainmentData[sample]) * wet);
+            }
+        });
+    }
+}
 
-            float am = 0.5f * (1.0f + std::sin(juce::MathConstants<float>::twoPi * beatHz * time));
-            am = juce::jlimit(0.0f, 1.0f, am * modDepthSmooth * 0.3f + 0.7f);
 
-            leftEntrainment *= am;
-            rightEntrainment *= am;
+// ============================================================================
+// MODE KERNELS
+// ============================================================================
 
-            leftEntrainment = leftFilter.process(leftEntrainment);
-            rightEntrainment = rightFilter.process(rightEntrainment);
+template <EntrainmentMode Mode, bool WithNoise, bool WithDrift>
+void BrainwaveEntrainmentAudioProcessor::renderEntrainment(const EntrainmentBlock& block) {
+    const auto& beatHz = block.beatHz;
+    const auto& carrier = block.carrier;
+    const auto& depth = block.depth;
+    auto noiseAmount = block.noiseAmount;
+    auto invSampleRate = block.invSampleRate;
+    auto numSamples = block.numSamples;
+
+    auto* beatRamp = controlBuffer.getWritePointer(BeatHzRamp);
+    auto* leftIncrements = controlBuffer.getWritePointer(LeftIncrement);
+    auto* rightIncrements = controlBuffer.getWritePointer(RightIncrement);
+    auto* offsetRamp = controlBuffer.getWritePointer(OffsetRamp);
+    auto* gateRamp = controlBuffer.getWritePointer(GateRamp);
+    auto* sharedNoise = controlBuffer.getWritePointer(SharedNoise);
+    auto* leftNoise = controlBuffer.getWritePointer(LeftNoise);
+    auto* rightNoise = controlBuffer.getWritePointer(RightNoise);
+    auto* leftOut = entrainmentBuffer.getWritePointer(0);
+    auto* rightOut = entrainmentBuffer.getWritePointer(1);
+
+    // ========================================================================
+    // BILATERAL SYNC MODE
+    // ========================================================================
+    if constexpr (Mode == EntrainmentMode::BilateralSync) {
+        // Left/right carriers are the shared carrier with the phase split
+        // +/-(beat / 2carrier + drift), rendered from one phasor pair.
+        // Without drift the last drift value holds, so it resumes smoothly.
+        if constexpr (WithDrift) {
+            driftLfo.processBlock(offsetRamp, 0.02f * block.hemiDrift, numSamples);
+            if (numSamples > 0)
+                driftOffset = offsetRamp[numSamples - 1];
         }
-        // ====================================================================
-        // STANDARD MODES
-        // ====================================================================
         else {
-            float leftTone = 0.0f;
-            float rightTone = 0.0f;
-
-            sharedPhase += carrier / static_cast<float>(sampleRate);
-            if (sharedPhase >= 1.0f) sharedPhase -= 1.0f;
-
-            switch (currentMode) {
-            case EntrainmentMode::Binaural: {
-                leftModOsc.setFrequency(carrier + beatHz * 0.5f);
-                rightModOsc.setFrequency(carrier - beatHz * 0.5f);
-                leftTone = leftModOsc.process();
-                rightTone = rightModOsc.process();
-                break;
-            }
+            std::fill(offsetRamp, offsetRamp + numSamples, driftOffset);
+        }
 
-            case EntrainmentMode::Monaural: {
-                leftModOsc.setFrequency(carrier + beatHz * 0.5f);
-                rightModOsc.setFrequency(carrier - beatHz * 0.5f);
-                float mono = (leftModOsc.process() + rightModOsc.process()) * 0.5f;
-                leftTone = mono;
-                rightTone = mono;
-                break;
-            }
+        beatHz.dispatch([&](auto beatAt) {
+            carrier.dispatch([&](auto carrierAt) {
+                for (int sample = 0; sample < numSamples; ++sample)
+                    offsetRamp[sample] = beatAt(sample) * 0.5f / carrierAt(sample) + offsetRamp[sample] * 0.1f;
+            });
+        });
 
-            case EntrainmentMode::Isochronic: {
-                carrierOsc.setFrequency(carrier);
-                float tone = carrierOsc.process();
-                float gate = 0.5f * (1.0f + std::sin(juce::MathConstants<float>::twoPi * beatHz * time));
-                gate = juce::jlimit(0.0f, 1.0f, gate * modDepthSmooth);
-                leftTone = tone * gate;
-                rightTone = tone * gate;
-                break;
-            }
+        stereoPhasors.processBlockWithOffsets(leftOut, rightOut, block.carrierRate, offsetRamp, numSamples);
+
+        // Constant-power correlated pair: two noise streams instead of three
+        if constexpr (WithNoise) {
+            noiseGen.generateCorrelatedBlock(leftNoise, rightNoise, correlationAmount, numSamples);
 
-            case EntrainmentMode::Hybrid: {
-                leftModOsc.setFrequency(carrier + beatHz * 0.5f);
-                rightModOsc.setFrequency(carrier - beatHz * 0.5f);
-                leftTone = leftModOsc.process();
-                rightTone = rightModOsc.process();
-
-                float gate = 0.5f * (1.0f + std::sin(juce::MathConstants<float>::twoPi * beatHz * time));
-                gate = juce::jlimit(0.0f, 1.0f, gate * modDepthSmooth * 0.5f + 0.5f);
-                leftTone *= gate;
-                rightTone *= gate;
-                break;
+            for (int sample = 0; sample < numSamples; ++sample) {
+                leftOut[sample] = leftOut[sample] * (1.0f - noiseAmount) + leftNoise[sample] * noiseAmount;
+                rightOut[sample] = rightOut[sample] * (1.0f - noiseAmount) + rightNoise[sample] * noiseAmount;
             }
+        }
+
+        beatHz.visit([&](auto beat) { gateLfo.processBlock(gateRamp, beat, numSamples); });
+
+        depth.dispatch([&](auto depthAt) {
+            for (int sample = 0; sample < numSamples; ++sample) {
+                float am = 0.5f * (1.0f + gateRamp[sample]);
+                am = juce::jlimit(0.0f, 1.0f, am * depthAt(sample) * 0.3f + 0.7f);
 
-            default:
-                break;
+                leftOut[sample] *= am;
+                rightOut[sample] *= am;
             }
+        });
 
-            if (noiseAmount > 0.01f) {
-                float noise = noiseGen.generatePink();
-                leftTone = leftTone * (1.0f - noiseAmount) + noise * noiseAmount;
-                rightTone = rightTone * (1.0f - noiseAmount) + noise * noiseAmount;
+        // Spectral asymmetry, both channels in one register
+        float* channels[] = { leftOut, rightOut };
+        spectralFilters.processBlock(channels, channels, 2, numSamples);
+    }
+    // ========================================================================
+    // STANDARD MODES
+    // ========================================================================
+    else {
+        bool usePhasorPair = Mode != EntrainmentMode::Isochronic
+            && currentWaveform == Waveform::Sine
+            && currentSineEngine == SineEngine::Quadrature;
+
+        if constexpr (Mode == EntrainmentMode::Isochronic) {
+            carrierOsc.processBlock(leftOut, block.carrierRate, numSamples);
+
+            if (currentPulseShape == PulseShape::Sine) {
+                beatHz.visit([&](auto beat) { gateLfo.processBlock(gateRamp, beat, numSamples); });
+                for (int sample = 0; sample < numSamples; ++sample)
+                    gateRamp[sample] = 0.5f * (1.0f + gateRamp[sample]);
+            }
+            else {
+                beatHz.visit([&](auto beat) { isochronicPulse.processBlock(gateRamp, beat, numSamples); });
             }
 
-            leftEntrainment = leftTone;
-            rightEntrainment = rightTone;
+            depth.dispatch([&](auto depthAt) {
+                for (int sample = 0; sample < numSamples; ++sample) {
+                    float gate = juce::jlimit(0.0f, 1.0f, gateRamp[sample] * depthAt(sample));
+                    leftOut[sample] *= gate;
+                    rightOut[sample] = leftOut[sample];
+                }
+            });
         }
+        else {
+            if (usePhasorPair) {
+                // sin(carrier +/- beat / 2) from the shared carrier phasor
+                const float* offsetRate = nullptr;
+                if (beatHz.isRamping()) {
+                    for (int sample = 0; sample < numSamples; ++sample)
+                        offsetRamp[sample] = beatRamp[sample] * 0.5f * invSampleRate;
+                    offsetRate = offsetRamp;
+                }
+
+                stereoPhasors.processBlock(leftOut, rightOut, block.carrierRate, offsetRate, numSamples);
+            }
+            else if (beatHz.isRamping() || carrier.isRamping()) {
+                beatHz.dispatch([&](auto beatAt) {
+                    carrier.dispatch([&](auto carrierAt) {
+                        for (int sample = 0; sample < numSamples; ++sample) {
+                            float halfBeat = beatAt(sample) * 0.5f;
+                            leftIncrements[sample] = (carrierAt(sample) + halfBeat) * invSampleRate;
+                            rightIncrements[sample] = (carrierAt(sample) - halfBeat) * invSampleRate;
+                        }
+                    });
+                });
+
+                leftModOsc.processBlock(leftOut, leftIncrements, numSamples);
+                rightModOsc.processBlock(rightOut, rightIncrements, numSamples);
+            }
+            else {
+                leftModOsc.setFrequency(carrier.value + beatHz.value * 0.5f);
+                rightModOsc.setFrequency(carrier.value - beatHz.value * 0.5f);
+                leftModOsc.processBlock(leftOut, nullptr, numSamples);
+                rightModOsc.processBlock(rightOut, nullptr, numSamples);
+            }
 
-        // Store entrainment signal
-        entrainmentBuffer.setSample(0, sample, leftEntrainment);
-        entrainmentBuffer.setSample(1, sample, rightEntrainment);
-    }
+            if constexpr (Mode == EntrainmentMode::Monaural) {
+                for (int sample = 0; sample < numSamples; ++sample) {
+                    float mono = (leftOut[sample] + rightOut[sample]) * 0.5f;
+                    leftOut[sample] = mono;
+                    rightOut[sample] = mono;
+                }
+            }
+            else if constexpr (Mode == EntrainmentMode::Hybrid) {
+                beatHz.visit([&](auto beat) { gateLfo.processBlock(gateRamp, beat, numSamples); });
+
+                depth.dispatch([&](auto depthAt) {
+                    for (int sample = 0; sample < numSamples; ++sample) {
+                        float gate = 0.5f * (1.0f + gateRamp[sample]);
+                        gate = juce::jlimit(0.0f, 1.0f, gate * depthAt(sample) * 0.5f + 0.5f);
+                        leftOut[sample] *= gate;
+                        rightOut[sample] *= gate;
+                    }
+                });
+            }
+            // Binaural: the detuned pair is the output
+        }
 
-    // Step 3: Mix input with entrainment signal using actual wet mix
-    for (int channel = 0; channel < numChannels; ++channel) {
-        auto* inputData = buffer.getWritePointer(channel);
-        auto* entrainmentData = entrainmentBuffer.getReadPointer(channel);
+        // Keep the shared carrier running so Bilateral Sync resumes smoothly
+        if (!usePhasorPair)
+            stereoPhasors.advanceCarrier(block.carrierRate, numSamples);
 
-        for (int sample = 0; sample < numSamples; ++sample) {
-            float wet = actualWetMix.getNextValue();
-            float dry = 1.0f - wet;
+        if constexpr (WithNoise) {
+            noiseGen.generateBlock(&sharedNoise, 1, numSamples);
 
-            inputData[sample] = (inputData[sample] * dry) + (entrainmentData[sample] * wet);
+            for (int sample = 0; sample < numSamples; ++sample) {
+                float noise = sharedNoise[sample];
+                leftOut[sample] = leftOut[sample] * (1.0f - noiseAmount) + noise * noiseAmount;
+                rightOut[sample] = rightOut[sample] * (1.0f - noiseAmount) + noise * noiseAmount;
+            }
         }
     }
+}
 
-    // Calculate RMS for monitoring
-    float leftAccum = 0.0f;
-    float rightAccum = 0.0f;
+// A tier's flattened wrapper; builds without dispatch fill every tier with the plain kernel
+template <SimdTier Tier, EntrainmentMode Mode, bool WithNoise, bool WithDrift>
+constexpr auto BrainwaveEntrainmentAudioProcessor::kernelFor() -> EntrainmentKernel {
+#if BRAINWAVE_SIMD_DISPATCH
+    if constexpr (Tier == SimdTier::Avx512)
+        return &BrainwaveEntrainmentAudioProcessor::renderEntrainmentAvx512<Mode, WithNoise, WithDrift>;
+    if constexpr (Tier == SimdTier::Avx2)
+        return &BrainwaveEntrainmentAudioProcessor::renderEntrainmentAvx2<Mode, WithNoise, WithDrift>;
+#endif
+    return &BrainwaveEntrainmentAudioProcessor::renderEntrainment<Mode, WithNoise, WithDrift>;
+}
 
-    for (int channel = 0; channel < numChannels; ++channel) {
-        auto* outputData = buffer.getReadPointer(channel);
-        for (int sample = 0; sample < numSamples; ++sample) {
-            if (channel == 0) leftAccum += outputData[sample] * outputData[sample];
-            if (channel == 1) rightAccum += outputData[sample] * outputData[sample];
-        }
-    }
+// Drift only exists in Bilateral Sync; the other modes share one kernel for both drift flags
+template <SimdTier Tier, EntrainmentMode Mode>
+constexpr auto BrainwaveEntrainmentAudioProcessor::kernelsForMode()
+    -> std::array<EntrainmentKernel, NumKernelVariants> {
+    constexpr bool hasDrift = Mode == EntrainmentMode::BilateralSync;
+
+    return { {
+        kernelFor<Tier, Mode, false, false>(),
+        kernelFor<Tier, Mode, true, false>(),
+        kernelFor<Tier, Mode, false, hasDrift>(),
+        kernelFor<Tier, Mode, true, hasDrift>()
+    } };
+}
 
-    if (numSamples > 0) {
-        leftRMS = std::sqrt(leftAccum / static_cast<float>(numSamples));
-        rightRMS = std::sqrt(rightAccum / static_cast<float>(numSamples));
-    }
+template <SimdTier Tier>
+constexpr auto BrainwaveEntrainmentAudioProcessor::kernelsForTier() -> KernelTable {
+    return { {
+        kernelsForMode<Tier, EntrainmentMode::Binaural>(),
+        kernelsForMode<Tier, EntrainmentMode::Monaural>(),
+        kernelsForMode<Tier, EntrainmentMode::Isochronic>(),
+        kernelsForMode<Tier, EntrainmentMode::Hybrid>(),
+        kernelsForMode<Tier, EntrainmentMode::BilateralSync>()
+    } };
 }
 
+// Indexed by SimdTier, EntrainmentMode, then KernelFlags
+const std::array<BrainwaveEntrainmentAudioProcessor::KernelTable, SimdDispatch::numTiers>
+BrainwaveEntrainmentAudioProcessor::entrainmentKernels = { {
+    kernelsForTier<SimdTier::Baseline>(),
+    kernelsForTier<SimdTier::Avx2>(),
+    kernelsForTier<SimdTier::Avx512>()
+} };
+
 // ============================================================================
 // PARAMETER HANDLING
 // ============================================================================
 
+// Called on the host's notification thread: hand the change to the audio thread
 void BrainwaveEntrainmentAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue) {
-    if (parameterID == "brainwave_frequency") {
-        currentFrequency = static_cast<BrainwaveFrequency>(static_cast<int>(newValue));
-        updateFrequencies();
-    }
-    else if (parameterID == "entrainment_mode") {
-        currentMode = static_cast<EntrainmentMode>(static_cast<int>(newValue));
-        updateFrequencies();
-    }
-    else if (parameterID == "carrier_frequency" || parameterID == "solfeggio_preset") {
-        updateFrequencies();
+    for (int i = 0; i < numParameterTargets; ++i) {
+        auto target = static_cast<ParameterTarget>(i);
+
+        if (parameterID == getParameterId(target)) {
+            commandQueue.push({ target, newValue });
+            return;
+        }
     }
-    else if (parameterID == "beat_offset") {
-        updateFrequencies();
+}
+
+const char* BrainwaveEntrainmentAudioProcessor::getParameterId(ParameterTarget target) {
+    switch (target) {
+    case ParameterTarget::EntrainmentMode:    return "entrainment_mode";
+    case ParameterTarget::Waveform:           return "waveform";
+    case ParameterTarget::SineEngine:         return "sine_engine";
+    case ParameterTarget::PulseWidth:         return "pulse_width";
+    case ParameterTarget::PinkNoiseAlgorithm: return "pink_noise_algorithm";
+    case ParameterTarget::NoiseColour:        return "noise_colour";
+    case ParameterTarget::ModulationDepth:    return "modulation_depth";
+    case ParameterTarget::IsochronicShape:    return "isochronic_shape";
+    case ParameterTarget::IsochronicDuty:     return "isochronic_duty";
+    case ParameterTarget::IsochronicEdge:     return "isochronic_edge";
+    default: break;
     }
-    else if (parameterID == "waveform") {
+
+    return "";
+}
+
+// Audio thread (or prepareToPlay, while nothing is rendering)
+void BrainwaveEntrainmentAudioProcessor::applyCommand(const ParameterCommand& command) {
+    auto newValue = command.value;
+
+    switch (command.target) {
+    case ParameterTarget::EntrainmentMode:
+        currentMode = static_cast<EntrainmentMode>(static_cast<int>(newValue));
+        break;
+
+    case ParameterTarget::Waveform: {
         auto waveform = static_cast<Waveform>(static_cast<int>(newValue));
+        currentWaveform = waveform;
         carrierOsc.setWaveform(waveform);
         leftModOsc.setWaveform(waveform);
         rightModOsc.setWaveform(waveform);
+        break;
     }
-    else if (parameterID == "wet_mix") {
-        wetMixSmooth.setTargetValue(newValue);
+
+    case ParameterTarget::PulseWidth:
+        carrierOsc.setPulseWidth(newValue);
+        leftModOsc.setPulseWidth(newValue);
+        rightModOsc.setPulseWidth(newValue);
+        break;
+
+    case ParameterTarget::SineEngine: {
+        auto engine = static_cast<SineEngine>(static_cast<int>(newValue));
+        currentSineEngine = engine;
+        carrierOsc.setSineEngine(engine);
+        leftModOsc.setSineEngine(engine);
+        rightModOsc.setSineEngine(engine);
+        break;
     }
-    else if (parameterID == "modulation_depth") {
+
+    case ParameterTarget::PinkNoiseAlgorithm:
+        noiseGen.setPinkAlgorithm(static_cast<PinkNoiseAlgorithm>(static_cast<int>(newValue)));
+        break;
+
+    case ParameterTarget::NoiseColour:
+        noiseGen.setColour(static_cast<NoiseColour>(static_cast<int>(newValue)));
+        break;
+
+    case ParameterTarget::IsochronicShape:
+        currentPulseShape = static_cast<PulseShape>(static_cast<int>(newValue));
+        isochronicPulse.setShape(currentPulseShape);
+        break;
+
+    case ParameterTarget::IsochronicDuty:
+        isochronicPulse.setDuty(newValue);
+        break;
+
+    case ParameterTarget::IsochronicEdge:
+        isochronicPulse.setEdgeTime(newValue * 0.001f);
+        break;
+
+    case ParameterTarget::ModulationDepth:
         modulationDepthSmooth.setTargetValue(newValue);
-    }
-    else if (parameterID == "operation_mode") {
-        currentOperationMode = static_cast<OperationMode>(static_cast<int>(newValue));
-    }
-    else if (parameterID == "gate_threshold") {
-        gateThresholdDB = newValue;
-    }
-    else if (parameterID == "auto_gain_sensitivity") {
-        autoGainSensitivity = newValue;
+        break;
+
+    default:
+        break;
     }
 }
 
-void BrainwaveEntrainmentAudioProcessor::updateFrequencies() {
-    // Get base brainwave frequency
-    float baseHz = 1.0f;
-    switch (currentFrequency) {
-    case BrainwaveFrequency::Delta: baseHz = 2.0f; break;
-    case BrainwaveFrequency::Theta: baseHz = 6.0f; break;
-    case BrainwaveFrequency::Alpha: baseHz = 10.0f; break;
-    case BrainwaveFrequency::Beta: baseHz = 20.0f; break;
-    case BrainwaveFrequency::Gamma: baseHz = 40.0f; break;
-    case BrainwaveFrequency::Focus3: baseHz = 4.0f; break;
-    case BrainwaveFrequency::Focus10: baseHz = 7.5f; break;
-    case BrainwaveFrequency::Focus12: baseHz = 10.0f; break;
-    case BrainwaveFrequency::Focus15: baseHz = 12.0f; break;
-    case BrainwaveFrequency::Focus21: baseHz = 20.0f; break;
-    }
+// Every listener-driven setting straight from its parameter, for when the
+// queue can't be trusted to hold every change
+void BrainwaveEntrainmentAudioProcessor::applyAllParameters() {
+    for (int i = 0; i < numParameterTargets; ++i)
+        applyCommand({ static_cast<ParameterTarget>(i), targetValues[static_cast<size_t>(i)]->load() });
+}
 
-    // Apply solfeggio preset if selected
-    int solfeggioPreset = static_cast<int>(parameters.getRawParameterValue("solfeggio_preset")->load());
-    float carrier = parameters.getRawParameterValue("carrier_frequency")->load();
-
-    // Override carrier with solfeggio frequency if not manual
-    if (solfeggioPreset > 0) {
-        switch (solfeggioPreset) {
-        case 1: carrier = 174.0f; break;  // UT
-        case 2: carrier = 285.0f; break;  // RE
-        case 3: carrier = 396.0f; break;  // MI
-        case 4: carrier = 417.0f; break;  // FA
-        case 5: carrier = 528.0f; break;  // SOL
-        case 6: carrier = 639.0f; break;  // LA
-        case 7: carrier = 741.0f; break;  // TI
-        case 8: carrier = 852.0f; break;
-        case 9: carrier = 963.0f; break;
-        }
+BrainwaveEntrainmentAudioProcessor::ParamSnapshot BrainwaveEntrainmentAudioProcessor::takeSnapshot() const {
+    ParamSnapshot snapshot;
+
+    auto band = static_cast<BrainwaveFrequency>(static_cast<int>(paramPointers.brainwaveFrequency->load()));
+    auto solfeggioPreset = static_cast<int>(paramPointers.solfeggioPreset->load());
+
+    snapshot.beatHz = juce::jlimit(0.5f, 100.0f, getBandHz(band) + paramPointers.beatOffset->load());
+    snapshot.carrierHz = getCarrierHz(solfeggioPreset, paramPointers.carrierFrequency->load());
+    snapshot.operationMode = static_cast<OperationMode>(static_cast<int>(paramPointers.operationMode->load()));
+    snapshot.wetMix = paramPointers.wetMix->load();
+    snapshot.gateThresholdDb = paramPointers.gateThreshold->load();
+    snapshot.autoGainSensitivity = paramPointers.autoGainSensitivity->load();
+    snapshot.noiseAmount = paramPointers.noiseAmount->load();
+    snapshot.hemiDrift = paramPointers.hemiDrift->load();
+    snapshot.hemiCorrelation = paramPointers.hemiCorrelation->load();
+    snapshot.masterGainDb = paramPointers.masterGain->load();
+
+    return snapshot;
+}
+
+float BrainwaveEntrainmentAudioProcessor::getBandHz(BrainwaveFrequency band) {
+    switch (band) {
+    case BrainwaveFrequency::Delta: return 2.0f;
+    case BrainwaveFrequency::Theta: return 6.0f;
+    case BrainwaveFrequency::Alpha: return 10.0f;
+    case BrainwaveFrequency::Beta: return 20.0f;
+    case BrainwaveFrequency::Gamma: return 40.0f;
+    case BrainwaveFrequency::Focus3: return 4.0f;
+    case BrainwaveFrequency::Focus10: return 7.5f;
+    case BrainwaveFrequency::Focus12: return 10.0f;
+    case BrainwaveFrequency::Focus15: return 12.0f;
+    case BrainwaveFrequency::Focus21: return 20.0f;
     }
 
-    // Add user offset
-    float beatOffset = parameters.getRawParameterValue("beat_offset")->load();
-    float finalBeatHz = juce::jlimit(0.5f, 100.0f, baseHz + beatOffset);
+    return 1.0f;
+}
 
-    currentBeatHz.setTargetValue(finalBeatHz);
-    carrierHz.setTargetValue(carrier);
+// Solfeggio frequency for presets 1..9, otherwise the manual carrier
+float BrainwaveEntrainmentAudioProcessor::getCarrierHz(int solfeggioPreset, float manualHz) {
+    switch (solfeggioPreset) {
+    case 1: return 174.0f;  // UT
+    case 2: return 285.0f;  // RE
+    case 3: return 396.0f;  // MI
+    case 4: return 417.0f;  // FA
+    case 5: return 528.0f;  // SOL
+    case 6: return 639.0f;  // LA
+    case 7: return 741.0f;  // TI
+    case 8: return 852.0f;
+    case 9: return 963.0f;
+    default: return manualHz;
+    }
 }
 
 // ============================================================================
@@ -471,9 +808,22 @@ BrainwaveEntrainmentAudioProcessor::createParameterLayout() {
         "waveform", "Waveform",
         juce::StringArray{
             "Sine", "Triangle", "Sawtooth", "Square", "Pulse",
-            "Noise", "Kick", "Snare", "Hat Closed", "Hat Open"
+            "Noise", "Kick", "Snare", "Hat Closed", "Hat Open",
+            "Triangle (BLEP)", "Sawtooth (BLEP)", "Square (BLEP)", "Pulse (BLEP)"
         }, 0));
 
+    // Pulse width for Pulse (BLEP)
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{ "pulse_width", 1 }, "Pulse Width",
+        juce::NormalisableRange<float>(0.05f, 0.95f, 0.01f), 0.25f,
+        juce::AudioParameterFloatAttributes().withStringFromValueFunction(
+            [](float value, int) { return juce::String(static_cast<int>(value * 100.0f)) + "%"; })));
+
+    // Sine engine
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "sine_engine", "Sine Engine",
+        juce::StringArray{ "Wavetable", "Quadrature" }, 0));
+
     // Modulation depth
     layout.add(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID{ "modulation_depth", 1 }, "Modulation Depth",
@@ -481,6 +831,23 @@ BrainwaveEntrainmentAudioProcessor::createParameterLayout() {
         juce::AudioParameterFloatAttributes().withStringFromValueFunction(
             [](float value, int) { return juce::String(static_cast<int>(value * 100.0f)) + "%"; })));
 
+    // Isochronic pulse shape
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "isochronic_shape", "Pulse Shape",
+        juce::StringArray{ "Sine", "Raised Cosine", "Trapezoid", "Exponential", "Band-Limited Square" }, 0));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{ "isochronic_duty", 1 }, "Pulse Duty",
+        juce::NormalisableRange<float>(0.05f, 0.95f, 0.01f), 0.5f,
+        juce::AudioParameterFloatAttributes().withStringFromValueFunction(
+            [](float value, int) { return juce::String(static_cast<int>(value * 100.0f)) + "%"; })));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{ "isochronic_edge", 1 }, "Pulse Edge",
+        juce::NormalisableRange<float>(1.0f, 100.0f, 0.1f), 10.0f,
+        juce::AudioParameterFloatAttributes().withStringFromValueFunction(
+            [](float value, int) { return juce::String(value, 1) + " ms"; })));
+
     // Noise amount
     layout.add(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID{ "noise_amount", 1 }, "Noise Mix",
@@ -488,6 +855,16 @@ BrainwaveEntrainmentAudioProcessor::createParameterLayout() {
         juce::AudioParameterFloatAttributes().withStringFromValueFunction(
             [](float value, int) { return juce::String(static_cast<int>(value * 100.0f)) + "%"; })));
 
+    // Pink noise algorithm
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "pink_noise_algorithm", "Pink Noise",
+        juce::StringArray{ "Kellet", "Voss-McCartney" }, 0));
+
+    // Noise colour
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "noise_colour", "Noise Colour",
+        juce::StringArray{ "White", "Pink", "Brown", "Blue", "Violet", "Grey" }, 1));
+
     // Bilateral Sync parameters
     layout.add(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID{ "hemisync_correlation", 1 }, "Noise Correlation",
@@ -1,7 +1,34 @@
 #pragma once
 #include <JuceHeader.h>
+#include <array>
 #include <random>
 #include <vector>
+#include <type_traits>
+#include "../Common/PhaseAccumulator.h"
+#include "WavetableBank.h"
+#include "../Common/BiquadLanes.h"
+#include "PhasorOscillators.h"
+#include "../Common/ControlRateLfo.h"
+#include "../Common/IsochronicPulse.h"
+#include "../Common/LevelDetector.h"
+#include "BlockSmoother.h"
+#include "../Common/CommandQueue.h"
+#include "../Common/MeterRing.h"
+#include "../Common/AllocationCheck.h"
+#include "../Common/SimdDispatch.h"
+#include "DrumSampleCache.h"
+#include "../Common/FastMath.h"
+#include "../Common/FastRandom.h"
+#include "../Common/NoiseGenerator.h"
+
+// ============================================================================
+// FAST MATH PRECISION PER CALL SITE
+// ============================================================================
+
+namespace MathTier {
+    constexpr auto amGate = FastMath::Precision::Standard;         // beat-rate gain curves
+    constexpr auto driftLfo = FastMath::Precision::Draft;          // sub-Hz phase wobble
+}
 
 // ============================================================================
 // ENUMS AND TYPES
@@ -38,7 +65,17 @@ enum class Waveform {
     DrumKick,
     DrumSnare,
     DrumHatClosed,
-    DrumHatOpen
+    DrumHatOpen,
+    TriangleBLEP,   // PolyBLEP / PolyBLAMP corrected shapes
+    SawtoothBLEP,
+    SquareBLEP,
+    PulseBLEP
+};
+
+// How BrainwaveOscillator renders the Sine waveform
+enum class SineEngine {
+    Wavetable = 0,
+    Quadrature = 1
 };
 
 // NEW: Operation Mode for mixing
@@ -55,8 +92,9 @@ enum class OperationMode {
 class BrainwaveOscillator {
 public:
     BrainwaveOscillator()
-        : randomGenerator(std::random_device{}()),
-        randomDistribution(-1.0f, 1.0f) {
+        : wavetables(WavetableBank::getShared()),
+        drums(DrumSampleCache::getShared()),
+        random(std::random_device{}()) {
     }
 
     void setSampleRate(double sr) {
@@ -70,197 +108,255 @@ public:
     }
 
     void setWaveform(Waveform wave) {
+        if (wave == Waveform::Sine && currentWaveform != Waveform::Sine)
+            quadrature.reset(Phase::toCycles(phase));
+
         currentWaveform = wave;
+        updateTable();
+    }
+
+    // Duty cycle of PulseBLEP, 0..1
+    void setPulseWidth(float width) {
+        pulseWidth = Phase::fromCycles(juce::jlimit(0.01f, 0.99f, width));
+    }
+
+    void setSineEngine(SineEngine engine) {
+        if (engine != sineEngine) {
+            sineEngine = engine;
+            quadrature.reset(Phase::toCycles(phase));
+        }
     }
 
     void setPhase(float ph) {
-        phase = ph;
+        phase = Phase::fromCycles(ph);
+        quadrature.reset(Phase::toCycles(phase));
     }
 
     float getPhase() const {
-        return phase;
+        return Phase::toCycles(phase);
     }
 
     void reset() {
-        phase = 0.0f;
-        envelopePhase = 0.0f;
+        phase = 0;
+        drumSample = 0;
+        quadrature.reset();
     }
 
     float process() {
         float sample = 0.0f;
+        processBlock(&sample, nullptr, 1);
+        return sample;
+    }
 
-        switch (currentWaveform) {
-        case Waveform::Sine:
-            sample = std::sin(phase * juce::MathConstants<float>::twoPi);
-            break;
-        case Waveform::Triangle:
-            sample = 2.0f * std::abs(2.0f * (phase - 0.5f)) - 1.0f;
-            break;
-        case Waveform::Sawtooth:
-            sample = 2.0f * phase - 1.0f;
-            break;
-        case Waveform::Square:
-            sample = phase < 0.5f ? 1.0f : -1.0f;
-            break;
-        case Waveform::Pulse:
-            sample = (phase < 0.25f) ? 1.0f : -1.0f;
-            break;
-        case Waveform::Noise:
-            sample = randomDistribution(randomGenerator);
-            break;
-        case Waveform::DrumKick:
-            sample = generateDrumKick();
-            break;
-        case Waveform::DrumSnare:
-            sample = generateDrumSnare();
-            break;
-        case Waveform::DrumHatClosed:
-            sample = generateHatClosed();
-            break;
-        case Waveform::DrumHatOpen:
-            sample = generateHatOpen();
-            break;
-        default:
-            sample = std::sin(phase * juce::MathConstants<float>::twoPi);
+    // Renders numSamples into output. phaseIncrements, if not null, holds one
+    // phase increment (frequency / sampleRate) per sample, e.g. a smoothed
+    // frequency ramp; otherwise the increment from setFrequency() is used.
+    // The waveform is dispatched once per block to a specialised loop.
+    void processBlock(float* output, const float* phaseIncrements, int numSamples) {
+        if (numSamples <= 0)
+            return;
+
+        if (phaseIncrements != nullptr) {
+            float maxIncrement = 0.0f;
+            for (int i = 0; i < numSamples; ++i)
+                maxIncrement = juce::jmax(maxIncrement, std::abs(phaseIncrements[i]));
+            updateTableLevel(maxIncrement);
+            renderBlock<true>(output, phaseIncrements, numSamples);
         }
-
-        phase += phaseIncrement;
-        if (phase >= 1.0f) {
-            phase -= 1.0f;
-            envelopePhase = 0.0f;
+        else {
+            renderBlock<false>(output, nullptr, numSamples);
         }
-
-        envelopePhase += phaseIncrement;
-
-        return sample;
     }
 
 private:
     Waveform currentWaveform = Waveform::Sine;
     double sampleRate = 44100.0;
     float frequency = 440.0f;
-    float phase = 0.0f;
-    float envelopePhase = 0.0f;
-    float phaseIncrement = 0.0f;
+    Phase::Type phase = 0;
+    Phase::Type phaseStep = 0;
+    float phaseIncrement = 0.0f;        // phaseStep in cycles, for table levels and BLEP widths
 
-    std::mt19937 randomGenerator;
-    std::uniform_real_distribution<float> randomDistribution;
+    // Shared band-limited tables for the periodic shapes
+    std::shared_ptr<const WavetableBank> wavetables;
+    const float* currentTable = wavetables->getTable(WavetableBank::Shape::Sine, 0);
+    int tableLevel = 0;
 
-    void updateIncrement() {
-        phaseIncrement = frequency / static_cast<float>(sampleRate);
-    }
+    Phase::Type pulseWidth = Phase::quarterCycle;
 
-    float generateDrumKick() {
-        float pitchEnv = std::exp(-envelopePhase * 15.0f);
-        float ampEnv = std::exp(-envelopePhase * 8.0f);
-        float kickFreq = 55.0f + 200.0f * pitchEnv;
-        return std::sin(kickFreq * envelopePhase * juce::MathConstants<float>::twoPi) * ampEnv;
-    }
+    // Shared pre-rendered drum hits; a new noise take is picked on every hit
+    std::shared_ptr<const DrumSampleCache> drums;
+    int drumVariation = 0;
+    int drumSample = 0;     // samples since the last hit
 
-    float generateDrumSnare() {
-        float ampEnv = std::exp(-envelopePhase * 12.0f);
-        float toneComponent = std::sin(200.0f * envelopePhase * juce::MathConstants<float>::twoPi) * 0.3f;
-        float noiseComponent = randomDistribution(randomGenerator) * 0.7f;
-        return (toneComponent + noiseComponent) * ampEnv;
-    }
+    // Alternative trig-free sine engine
+    SineEngine sineEngine = SineEngine::Wavetable;
+    QuadratureOscillator quadrature;
+
+    FastRandom random;
 
-    float generateHatClosed() {
-        float ampEnv = std::exp(-envelopePhase * 25.0f);
-        return randomDistribution(randomGenerator) * ampEnv * 0.5f;
+    void updateIncrement() {
+        auto increment = static_cast<double>(frequency) / sampleRate;
+        phaseStep = Phase::fromCycles(increment);
+        phaseIncrement = static_cast<float>(increment);
+        updateTableLevel(phaseIncrement);
+        quadrature.setIncrement(increment);
     }
 
-    float generateHatOpen() {
-        float ampEnv = std::exp(-envelopePhase * 8.0f);
-        return randomDistribution(randomGenerator) * ampEnv * 0.4f;
+    void updateTableLevel(float increment) {
+        auto level = WavetableBank::getLevelForIncrement(increment);
+        if (level != tableLevel) {
+            tableLevel = level;
+            updateTable();
+        }
     }
-};
 
-// ============================================================================
-// NOISE GENERATOR
-// ============================================================================
+    void updateTable() {
+        auto shape = WavetableBank::Shape::Sine;
 
-class NoiseGenerator {
-public:
-    NoiseGenerator()
-        : randomEngine(std::random_device{}()),
-        distribution(-1.0f, 1.0f) {
-        for (int i = 0; i < 7; ++i)
-            pinkState[i] = 0.0f;
-    }
+        switch (currentWaveform) {
+        case Waveform::Triangle: shape = WavetableBank::Shape::Triangle; break;
+        case Waveform::Sawtooth: shape = WavetableBank::Shape::Sawtooth; break;
+        case Waveform::Square:   shape = WavetableBank::Shape::Square; break;
+        case Waveform::Pulse:    shape = WavetableBank::Shape::Pulse; break;
+        default: break;
+        }
 
-    float generateWhite() {
-        return distribution(randomEngine);
+        currentTable = wavetables->getTable(shape, tableLevel);
     }
 
-    float generatePink() {
-        float white = distribution(randomEngine);
-
-        pinkState[0] = 0.99886f * pinkState[0] + white * 0.0555179f;
-        pinkState[1] = 0.99332f * pinkState[1] + white * 0.0750759f;
-        pinkState[2] = 0.96900f * pinkState[2] + white * 0.1538520f;
-        pinkState[3] = 0.86650f * pinkState[3] + white * 0.3104856f;
-        pinkState[4] = 0.55000f * pinkState[4] + white * 0.5329522f;
-        pinkState[5] = -0.7616f * pinkState[5] - white * 0.0168980f;
+    template <bool PerSampleIncrement>
+    void renderBlock(float* output, const float* phaseIncrements, int numSamples) {
+        if (currentWaveform == Waveform::Sine && sineEngine == SineEngine::Quadrature) {
+            quadrature.processBlock(output, phaseIncrements, numSamples);
+            phase = Phase::fromCycles(quadrature.getPhase());
+            return;
+        }
 
-        float pink = pinkState[0] + pinkState[1] + pinkState[2] +
-            pinkState[3] + pinkState[4] + pinkState[5] +
-            pinkState[6] + white * 0.5362f;
-        pinkState[6] = white * 0.115926f;
+        switch (currentWaveform) {
+        case Waveform::Noise:         renderLoop<Waveform::Noise, PerSampleIncrement>(output, phaseIncrements, numSamples); break;
+        case Waveform::DrumKick:      renderLoop<Waveform::DrumKick, PerSampleIncrement>(output, phaseIncrements, numSamples); break;
+        case Waveform::DrumSnare:     renderLoop<Waveform::DrumSnare, PerSampleIncrement>(output, phaseIncrements, numSamples); break;
+        case Waveform::DrumHatClosed: renderLoop<Waveform::DrumHatClosed, PerSampleIncrement>(output, phaseIncrements, numSamples); break;
+        case Waveform::DrumHatOpen:   renderLoop<Waveform::DrumHatOpen, PerSampleIncrement>(output, phaseIncrements, numSamples); break;
+        case Waveform::TriangleBLEP:  renderLoop<Waveform::TriangleBLEP, PerSampleIncrement>(output, phaseIncrements, numSamples); break;
+        case Waveform::SawtoothBLEP:  renderLoop<Waveform::SawtoothBLEP, PerSampleIncrement>(output, phaseIncrements, numSamples); break;
+        case Waveform::SquareBLEP:    renderLoop<Waveform::SquareBLEP, PerSampleIncrement>(output, phaseIncrements, numSamples); break;
+        case Waveform::PulseBLEP:     renderLoop<Waveform::PulseBLEP, PerSampleIncrement>(output, phaseIncrements, numSamples); break;
+        default:                      renderLoop<Waveform::Sine, PerSampleIncrement>(output, phaseIncrements, numSamples); break; // all table shapes
+        }
+    }
 
-        return pink * 0.11f;
+    static constexpr bool isDrum(Waveform wave) {
+        return wave == Waveform::DrumKick || wave == Waveform::DrumSnare
+            || wave == Waveform::DrumHatClosed || wave == Waveform::DrumHatOpen;
     }
 
-private:
-    std::mt19937 randomEngine;
-    std::uniform_real_distribution<float> distribution;
-    float pinkState[7];
-};
+    static constexpr DrumSampleCache::Drum drumForWaveform(Waveform wave) {
+        return wave == Waveform::DrumSnare ? DrumSampleCache::Drum::Snare
+            : wave == Waveform::DrumHatClosed ? DrumSampleCache::Drum::HatClosed
+            : wave == Waveform::DrumHatOpen ? DrumSampleCache::Drum::HatOpen
+            : DrumSampleCache::Drum::Kick;
+    }
 
-// ============================================================================
-// SIMPLE BIQUAD FILTER
-// ============================================================================
+    template <Waveform Shape, bool PerSampleIncrement>
+    void renderLoop(float* output, const float* phaseIncrements, int numSamples) {
+        auto* table = currentTable;
+        auto& drumCache = *drums;
+        auto& drumVoice = drumCache.getVoice(drumForWaveform(Shape));
+
+        if constexpr (Shape == Waveform::Noise)
+            random.generateBlock(output, numSamples);
+
+        for (int i = 0; i < numSamples; ++i) {
+            auto increment = PerSampleIncrement ? phaseIncrements[i] : phaseIncrement;
+            auto step = PerSampleIncrement ? Phase::fromIncrement(increment) : phaseStep;
+
+            if constexpr (isDrum(Shape))
+                output[i] = drumCache.read(drumVoice, phase, drumSample, drumVariation);
+            else if constexpr (Shape == Waveform::TriangleBLEP)
+                output[i] = generateTriangleBLEP(increment);
+            else if constexpr (Shape == Waveform::SawtoothBLEP)
+                output[i] = generateSawtoothBLEP(increment);
+            else if constexpr (Shape == Waveform::SquareBLEP)
+                output[i] = generatePulseBLEP(Phase::halfCycle, increment);
+            else if constexpr (Shape == Waveform::PulseBLEP)
+                output[i] = generatePulseBLEP(pulseWidth, increment);
+            else if constexpr (Shape != Waveform::Noise) // noise is rendered above
+                output[i] = WavetableBank::read(table, phase);
+
+            auto previous = phase;
+            phase += step;
+
+            // Each wrap starts a new hit
+            if constexpr (isDrum(Shape)) {
+                if (phase < previous)
+                    nextDrumVariation();
+                else
+                    drumSample = (drumSample + 1) & (DrumSampleCache::noiseLength - 1);
+            }
+        }
+    }
 
-class SimpleBiquad {
-public:
-    void setLowpass(double sampleRate, float cutoffHz, float Q = 0.707f) {
-        float w0 = juce::MathConstants<float>::twoPi * cutoffHz / static_cast<float>(sampleRate);
-        float cosw0 = std::cos(w0);
-        float sinw0 = std::sin(w0);
-        float alpha = sinw0 / (2.0f * Q);
-
-        float b0_temp = (1.0f - cosw0) / 2.0f;
-        float b1_temp = 1.0f - cosw0;
-        float b2_temp = (1.0f - cosw0) / 2.0f;
-        float a0_temp = 1.0f + alpha;
-        float a1_temp = -2.0f * cosw0;
-        float a2_temp = 1.0f - alpha;
-
-        b0 = b0_temp / a0_temp;
-        b1 = b1_temp / a0_temp;
-        b2 = b2_temp / a0_temp;
-        a1 = a1_temp / a0_temp;
-        a2 = a2_temp / a0_temp;
+    // Never repeats the previous take
+    void nextDrumVariation() {
+        drumSample = 0;
+        auto step = 1 + random.nextInt(DrumSampleCache::numNoiseVariations - 1);
+        drumVariation = (drumVariation + step) % DrumSampleCache::numNoiseVariations;
     }
 
-    float process(float input) {
-        float output = b0 * input + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+    // ------------------------------------------------------------------------
+    // PolyBLEP / PolyBLAMP shapes
+    //
+    // Two-sample polynomial residuals around each discontinuity, for a unit
+    // step (BLEP) and a unit change of slope per sample (BLAMP). t is the
+    // phase measured from the discontinuity, dt the phase increment.
+    // ------------------------------------------------------------------------
+
+    static float blepResidual(float t, float dt) {
+        if (t < dt) {
+            auto x = t / dt - 1.0f;
+            return -0.5f * x * x;
+        }
+        if (t > 1.0f - dt) {
+            auto x = (t - 1.0f) / dt + 1.0f;
+            return 0.5f * x * x;
+        }
+        return 0.0f;
+    }
 
-        x2 = x1;
-        x1 = input;
-        y2 = y1;
-        y1 = output;
+    static float blampResidual(float t, float dt) {
+        if (t < dt) {
+            auto x = 1.0f - t / dt;
+            return x * x * x * (1.0f / 6.0f);
+        }
+        if (t > 1.0f - dt) {
+            auto x = (t - 1.0f) / dt + 1.0f;
+            return x * x * x * (1.0f / 6.0f);
+        }
+        return 0.0f;
+    }
 
-        return output;
+    // Offsets from the discontinuities are plain integer differences, which
+    // wrap by themselves
+    float generateSawtoothBLEP(float dt) const {
+        // Falls by 2 at the wrap
+        auto t = Phase::toCycles(phase);
+        return 2.0f * t - 1.0f - 2.0f * blepResidual(t, dt);
     }
 
-    void reset() {
-        x1 = x2 = y1 = y2 = 0.0f;
+    float generatePulseBLEP(Phase::Type width, float dt) const {
+        // Rises by 2 at phase 0, falls by 2 at phase == width
+        float naive = phase < width ? 1.0f : -1.0f;
+        return naive + 2.0f * blepResidual(Phase::toCycles(phase), dt)
+            - 2.0f * blepResidual(Phase::toCycles(phase - width), dt);
     }
 
-private:
-    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f;
-    float a1 = 0.0f, a2 = 0.0f;
-    float x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f;
+    float generateTriangleBLEP(float dt) const {
+        // Slope (per cycle) turns from +4 to -4 at phase 0 and back at 0.5
+        auto t = Phase::toCycles(phase);
+        float naive = 2.0f * std::abs(2.0f * (t - 0.5f)) - 1.0f;
+        return naive + 8.0f * dt * (blampResidual(Phase::toCycles(phase + Phase::halfCycle), dt) - blampResidual(t, dt));
+    }
 };
 
 // ============================================================================
@@ -276,6 +372,8 @@ public:
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -300,16 +398,146 @@ public:
 
     float getCurrentBeatFrequency() const { return currentBeatHz.getCurrentValue(); }
 
-    // Monitoring
-    float getLeftRMSLevel() const { return leftRMS; }
-    float getRightRMSLevel() const { return rightRMS; }
+    // Monitoring: one frame per block, drained by the editor
+    using MeterQueue = MeterRing<256>;
+    MeterQueue& getMeterRing() { return meterRing; }
 
 private:
     void parameterChanged(const juce::String& parameterID, float newValue) override;
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
-    void updateFrequencies();
-    void applyEntrainmentToInput(juce::AudioBuffer<float>& buffer);
+    // Parameter values for one block, gathered at block start from atomics
+    // resolved once at construction, plus the frequencies derived from them
+    struct ParamSnapshot {
+        float beatHz = 10.0f;               // band + beat offset
+        float carrierHz = 100.0f;           // solfeggio preset or manual carrier
+        OperationMode operationMode = OperationMode::AlwaysOn;
+        float wetMix = 0.5f;
+        float gateThresholdDb = -40.0f;
+        float autoGainSensitivity = 0.5f;
+        float noiseAmount = 0.0f;
+        float hemiDrift = 0.0f;
+        float hemiCorrelation = 1.0f;
+        float masterGainDb = 0.0f;
+    };
+
+    struct ParameterPointers {
+        std::atomic<float>* brainwaveFrequency = nullptr;
+        std::atomic<float>* beatOffset = nullptr;
+        std::atomic<float>* carrierFrequency = nullptr;
+        std::atomic<float>* solfeggioPreset = nullptr;
+        std::atomic<float>* operationMode = nullptr;
+        std::atomic<float>* wetMix = nullptr;
+        std::atomic<float>* gateThreshold = nullptr;
+        std::atomic<float>* autoGainSensitivity = nullptr;
+        std::atomic<float>* noiseAmount = nullptr;
+        std::atomic<float>* hemiDrift = nullptr;
+        std::atomic<float>* hemiCorrelation = nullptr;
+        std::atomic<float>* masterGain = nullptr;
+    };
+
+    // Settings driven by parameter listeners. Listeners only enqueue; the
+    // audio thread applies them, so oscillator and smoother state is never
+    // touched from another thread.
+    enum class ParameterTarget {
+        EntrainmentMode = 0,
+        Waveform,
+        SineEngine,
+        PulseWidth,
+        PinkNoiseAlgorithm,
+        NoiseColour,
+        ModulationDepth,
+        IsochronicShape,
+        IsochronicDuty,
+        IsochronicEdge,
+        NumTargets
+    };
+
+    struct ParameterCommand {
+        ParameterTarget target = ParameterTarget::NumTargets;
+        float value = 0.0f;
+    };
+
+    static constexpr int numParameterTargets = static_cast<int>(ParameterTarget::NumTargets);
+
+    static const char* getParameterId(ParameterTarget target);
+    void applyCommand(const ParameterCommand& command);
+    void applyAllParameters();
+
+    ParamSnapshot takeSnapshot() const;
+    static float getBandHz(BrainwaveFrequency band);
+    static float getCarrierHz(int solfeggioPreset, float manualHz);
+
+    template <typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer);
+
+    template <typename SampleType>
+    void applyEntrainmentToInput(juce::AudioBuffer<SampleType>& buffer, const ParamSnapshot& snapshot);
+
+    // Crossfades the input towards entrainmentBuffer by the wet ramp times
+    // the operation mode's gain
+    template <typename SampleType>
+    void mixEntrainment(juce::AudioBuffer<SampleType>& buffer, const SmoothedBlock& wetMix, const float* modeGain);
+
+#if BRAINWAVE_SIMD_DISPATCH
+    template <typename SampleType>
+    BRAINWAVE_TARGET_AVX2 void mixEntrainmentAvx2(juce::AudioBuffer<SampleType>& buffer, const SmoothedBlock& wetMix, const float* modeGain) {
+        mixEntrainment(buffer, wetMix, modeGain);
+    }
+
+    template <typename SampleType>
+    BRAINWAVE_TARGET_AVX512 void mixEntrainmentAvx512(juce::AudioBuffer<SampleType>& buffer, const SmoothedBlock& wetMix, const float* modeGain) {
+        mixEntrainment(buffer, wetMix, modeGain);
+    }
+#endif
+
+    // One block of smoothed entrainment parameters, handed to the mode kernel
+    struct EntrainmentBlock {
+        SmoothedBlock beatHz;
+        SmoothedBlock carrier;
+        SmoothedBlock depth;
+        const float* carrierRate = nullptr;   // per-sample increments, or null when constant
+        float noiseAmount = 0.0f;
+        float hemiDrift = 0.0f;
+        float invSampleRate = 0.0f;
+        int numSamples = 0;
+    };
+
+    // Renders the entrainment signal for one mode into entrainmentBuffer.
+    // Noise and drift are compile-time flags, so the sample loops carry no
+    // mode or feature tests; the kernel is picked once per block from
+    // entrainmentKernels, for the SIMD tier chosen in prepareToPlay.
+    template <EntrainmentMode Mode, bool WithNoise, bool WithDrift>
+    void renderEntrainment(const EntrainmentBlock& block);
+
+#if BRAINWAVE_SIMD_DISPATCH
+    template <EntrainmentMode Mode, bool WithNoise, bool WithDrift>
+    BRAINWAVE_TARGET_AVX2 void renderEntrainmentAvx2(const EntrainmentBlock& block) {
+        renderEntrainment<Mode, WithNoise, WithDrift>(block);
+    }
+
+    template <EntrainmentMode Mode, bool WithNoise, bool WithDrift>
+    BRAINWAVE_TARGET_AVX512 void renderEntrainmentAvx512(const EntrainmentBlock& block) {
+        renderEntrainment<Mode, WithNoise, WithDrift>(block);
+    }
+#endif
+
+    using EntrainmentKernel = void (BrainwaveEntrainmentAudioProcessor::*)(const EntrainmentBlock&);
+    enum KernelFlags { NoiseOn = 1, DriftOn = 2, NumKernelVariants = 4 };
+
+    static constexpr size_t numEntrainmentModes = 5;
+    using KernelTable = std::array<std::array<EntrainmentKernel, NumKernelVariants>, numEntrainmentModes>;
+
+    template <SimdTier Tier, EntrainmentMode Mode, bool WithNoise, bool WithDrift>
+    static constexpr EntrainmentKernel kernelFor();
+
+    template <SimdTier Tier, EntrainmentMode Mode>
+    static constexpr std::array<EntrainmentKernel, NumKernelVariants> kernelsForMode();
+
+    template <SimdTier Tier>
+    static constexpr KernelTable kernelsForTier();
+
+    static const std::array<KernelTable, SimdDispatch::numTiers> entrainmentKernels;
 
     // Oscillators
     BrainwaveOscillator carrierOsc;
@@ -317,46 +545,84 @@ private:
     BrainwaveOscillator rightModOsc;
     NoiseGenerator noiseGen;
 
-    // Filters for spectral asymmetry
-    SimpleBiquad leftFilter;
-    SimpleBiquad rightFilter;
+    // Filters for spectral asymmetry: lane 0 left, lane 1 right
+    BiquadLanes spectralFilters;
 
     // Parameters
     juce::AudioProcessorValueTreeState parameters;
+    ParameterPointers paramPointers;
+    std::array<std::atomic<float>*, numParameterTargets> targetValues{};
+    CommandQueue<ParameterCommand, 256> commandQueue;
 
     // State
     double sampleRate = 44100.0;
+    SimdTier simdTier = SimdTier::Baseline;
 
-    // Smoothed values
-    juce::SmoothedValue<float> currentBeatHz{ 1.0f };
-    juce::SmoothedValue<float> carrierHz{ 100.0f };
-    juce::SmoothedValue<float> wetMixSmooth{ 0.5f };
-    juce::SmoothedValue<float> modulationDepthSmooth{ 0.8f };
+    // Smoothed values, rendered a block at a time
+    BlockSmoother currentBeatHz{ 1.0f };
+    BlockSmoother carrierHz{ 100.0f };
+    BlockSmoother modulationDepthSmooth{ 0.8f };
 
     // NEW: Mix mode smoothing
-    juce::SmoothedValue<float> actualWetMix{ 0.5f };
-    juce::SmoothedValue<float> inputEnvelope{ 0.0f };
+    BlockSmoother actualWetMix{ 0.5f };
+
+    // Input level for Gate Trigger / Auto Gain
+    LevelDetector inputDetector;
+    DetectorGate inputGate;
+
+    // Shared carrier phasor pair (binaural pairs and Bilateral Sync)
+    StereoPhasorPair stereoPhasors;
+
+    // Beat-rate gain curve (Isochronic, Hybrid, Bilateral Sync AM), phase
+    // continuous across blocks
+    ControlRateLfo<MathTier::amGate> gateLfo;
+
+    // Shaped Isochronic pulses; PulseShape::Sine uses gateLfo instead
+    IsochronicPulse isochronicPulse;
 
     // Bilateral Sync specific
-    float sharedPhase = 0.0f;
-    float driftPhase = 0.0f;
+    ControlRateLfo<MathTier::driftLfo> driftLfo;
+    float driftOffset = 0.0f;       // held while drift is off
     float correlationAmount = 1.0f;
 
-    // NEW: Operation mode and settings
-    OperationMode currentOperationMode = OperationMode::AlwaysOn;
-    float gateThresholdDB = -40.0f;
-    float autoGainSensitivity = 0.5f;
-
     // Current settings
     EntrainmentMode currentMode = EntrainmentMode::Binaural;
-    BrainwaveFrequency currentFrequency = BrainwaveFrequency::Alpha;
+    Waveform currentWaveform = Waveform::Sine;
+    SineEngine currentSineEngine = SineEngine::Wavetable;
+    PulseShape currentPulseShape = PulseShape::Sine;
 
     // Monitoring
-    float leftRMS = 0.0f;
-    float rightRMS = 0.0f;
+    MeterQueue meterRing;
+    MeterAccumulator blockMeters;       // the chunks of the current block
+
+    // Host blocks are rendered in chunks of at most this many samples, so the
+    // scratch buffers below are sized once in prepareToPlay
+    static constexpr int processingChunkSize = 64;
 
     // Buffer for generated entrainment signal
     juce::AudioBuffer<float> entrainmentBuffer;
 
+    // Per-sample control signals for the current block
+    enum ControlChannel {
+        BeatHzRamp = 0,
+        CarrierHzRamp,
+        DepthRamp,
+        LeftIncrement,
+        RightIncrement,
+        CarrierIncrement,
+        OffsetRamp,
+        GateRamp,
+        SharedNoise,
+        LeftNoise,
+        RightNoise,
+        InputLeft,          // float copy of a double-precision input, for the detector
+        InputRight,
+        InputEnvelope,
+        ModeGain,
+        WetRamp,
+        NumControlChannels
+    };
+    juce::AudioBuffer<float> controlBuffer;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BrainwaveEntrainmentAudioProcessor)
 };
\ No newline at end of file
@@ -0,0 +1,156 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "../Common/PhaseAccumulator.h"
+
+// ============================================================================
+// BAND-LIMITED WAVETABLE BANK
+// ============================================================================
+//
+// One table per shape and per octave of phase increment. Level k holds the
+// first (maxHarmonics >> k) harmonics, so a tone whose phase increment is at
+// most 0.5 / (maxHarmonics >> k) reads a table with nothing above Nyquist.
+// Because the levels are keyed on phase increment rather than Hz, the same
+// tables serve every sample rate: the bank is built once and shared read-only
+// by every oscillator in the process.
+
+class WavetableBank {
+public:
+    enum class Shape {
+        Sine = 0,
+        Triangle,
+        Sawtooth,
+        Square,
+        Pulse,
+        NumShapes
+    };
+
+    static constexpr int tableBits = 11;
+    static constexpr int tableSize = 1 << tableBits;
+    static constexpr int tableMask = tableSize - 1;
+    static constexpr int maxHarmonics = 512;
+    static constexpr int numLevels = 10;      // 512, 256, ... 1 harmonics
+    static constexpr float pulseDuty = 0.25f;  // matches the naive Pulse shape
+
+    static std::shared_ptr<const WavetableBank> getShared() {
+        static std::mutex creationLock;
+        static std::weak_ptr<const WavetableBank> sharedBank;
+
+        const std::lock_guard<std::mutex> lock(creationLock);
+        auto bank = sharedBank.lock();
+        if (bank == nullptr) {
+            bank = std::make_shared<const WavetableBank>();
+            sharedBank = bank;
+        }
+        return bank;
+    }
+
+    WavetableBank() {
+        for (int i = 0; i < tableSize; ++i)
+            sineLookup[static_cast<size_t>(i)] = std::sin(juce::MathConstants<double>::twoPi * i / tableSize);
+
+        buildTable(Shape::Sine, 0);
+
+        for (int shape = static_cast<int>(Shape::Triangle); shape < static_cast<int>(Shape::NumShapes); ++shape)
+            for (int level = 0; level < numLevels; ++level)
+                buildTable(static_cast<Shape>(shape), level);
+    }
+
+    // Highest-resolution level whose harmonics all stay below Nyquist.
+    static int getLevelForIncrement(float phaseIncrement) {
+        auto increment = std::abs(phaseIncrement);
+        int level = 0;
+        while (level < numLevels - 1 && static_cast<float>(maxHarmonics >> level) * increment > 0.5f)
+            ++level;
+        return level;
+    }
+
+    // Returns tableSize + 1 samples; the last one repeats the first so the
+    // interpolating reader never needs to wrap.
+    const float* getTable(Shape shape, int level) const {
+        if (shape == Shape::Sine)
+            level = 0;
+        return tables[static_cast<size_t>(shape)][static_cast<size_t>(level)].data();
+    }
+
+    // The top tableBits of the phase are the index, the rest the fraction
+    static float read(const float* table, Phase::Type phase) {
+        auto index = Phase::index<tableBits>(phase);
+        auto frac = Phase::fraction<tableBits>(phase);
+        return table[index] + frac * (table[index + 1] - table[index]);
+    }
+
+private:
+    using Table = std::vector<float>;
+
+    std::array<double, tableSize> sineLookup{};
+    std::array<std::array<Table, numLevels>, static_cast<size_t>(Shape::NumShapes)> tables;
+
+    double sinLookup(juce::int64 index) const {
+        return sineLookup[static_cast<size_t>(index & tableMask)];
+    }
+
+    double cosLookup(juce::int64 index) const {
+        return sinLookup(index + tableSize / 4);
+    }
+
+    // Additive synthesis of the Fourier series of each naive shape, truncated
+    // at the level's harmonic limit.
+    void buildTable(Shape shape, int level) {
+        auto numHarmonics = maxHarmonics >> level;
+        std::vector<double> accum(tableSize, 0.0);
+
+        if (shape == Shape::Sine) {
+            for (int i = 0; i < tableSize; ++i)
+                accum[static_cast<size_t>(i)] = sinLookup(i);
+        }
+        else if (shape == Shape::Pulse) {
+            // 2 * rect(duty) - 1 = (2d - 1) + sum 4/(pi h) sin(pi h d) cos(2 pi h (x - d/2))
+            auto offset = static_cast<juce::int64>(pulseDuty * 0.5f * tableSize);
+            for (int i = 0; i < tableSize; ++i)
+                accum[static_cast<size_t>(i)] = 2.0 * pulseDuty - 1.0;
+
+            for (int h = 1; h <= numHarmonics; ++h) {
+                auto amplitude = 4.0 / (juce::MathConstants<double>::pi * h)
+                    * std::sin(juce::MathConstants<double>::pi * h * pulseDuty);
+                for (int i = 0; i < tableSize; ++i)
+                    accum[static_cast<size_t>(i)] += amplitude * cosLookup(h * (i - offset));
+            }
+        }
+        else {
+            auto oddOnly = shape != Shape::Sawtooth;
+
+            for (int h = 1; h <= numHarmonics; h += oddOnly ? 2 : 1) {
+                for (int i = 0; i < tableSize; ++i) {
+                    auto index = static_cast<juce::int64>(h) * i;
+                    double term = 0.0;
+
+                    switch (shape) {
+                    case Shape::Triangle: // 8/pi^2 sum cos(2 pi h x) / h^2, odd h
+                        term = 8.0 / (juce::MathConstants<double>::pi * juce::MathConstants<double>::pi * h * h) * cosLookup(index);
+                        break;
+                    case Shape::Sawtooth: // 2x - 1 = -2/pi sum sin(2 pi h x) / h
+                        term = -2.0 / (juce::MathConstants<double>::pi * h) * sinLookup(index);
+                        break;
+                    case Shape::Square:   // 4/pi sum sin(2 pi h x) / h, odd h
+                        term = 4.0 / (juce::MathConstants<double>::pi * h) * sinLookup(index);
+                        break;
+                    default:
+                        break;
+                    }
+
+                    accum[static_cast<size_t>(i)] += term;
+                }
+            }
+        }
+
+        auto& table = tables[static_cast<size_t>(shape)][static_cast<size_t>(level)];
+        table.resize(tableSize + 1);
+        for (int i = 0; i < tableSize; ++i)
+            table[static_cast<size_t>(i)] = static_cast<float>(accum[static_cast<size_t>(i)]);
+        table[tableSize] = table[0];
+    }
+};